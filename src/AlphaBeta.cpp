@@ -3,10 +3,14 @@
  */
 
 #include "AlphaBeta.hpp"
+#include "Search.hpp"
+#include "SearchStats.hpp"
 #include <omp.h>
 
+#include <atomic>
 #include <memory>
 #include <numeric>
+#include <utility>
 
 // Combiner expressions for the custom reductions
 void combinerMin(const chess::Move& in, chess::Move& out) {
@@ -21,58 +25,641 @@ void combinerMax(const chess::Move& in, chess::Move& out) {
 #pragma omp declare reduction(moveMin : chess::Move : combinerMin(omp_out, omp_in)) initializer(omp_priv = omp_orig)
 #pragma omp declare reduction(moveMax : chess::Move : combinerMax(omp_out, omp_in)) initializer(omp_priv = omp_orig)
 
-AlphaBetaResult
-alphaBeta(
-    const SequentialTag& policy,
-    const GameNode& gameNode,
-    std::uint8_t depth,
-    std::int16_t alpha,
-    std::int16_t beta,
-    bool isMaximizingPlayer
-) {
-    // Return if the maximum depth has been explored or there are no legal moves remaining
-    if (depth == 0 || gameNode.children().empty()) {
+namespace { // anonymous namespace
+    /**
+     * @brief Look up a position and decide its node from the stored entry if it is deep enough and
+     * its bound falls outside the current window. Entries are stored relative to the side to move, so
+     * the score and bound are mirrored for the minimizing player. The table is bound to material scores.
+     *
+     * @return Whether the node was decided, in which case result holds the stored best move and score.
+     */
+    bool probeTable(
+        TranspositionTable* table,
+        const chess::Board& board,
+        std::uint8_t depth,
+        std::int16_t alpha,
+        std::int16_t beta,
+        bool isMaximizingPlayer,
+        AlphaBetaResult& result
+    ) {
+        TableEntry entry;
+        if (table == nullptr || depth == 0) {
+            return false;
+        }
+        table->bindScale(ScoreScale::MATERIAL);
+        const bool found = table->probe(board.hash(), entry);
+        stats::tableProbe(found);
+        if (!found || entry.depth < depth) {
+            return false;
+        }
+        auto score = isMaximizingPlayer ? entry.score : static_cast<std::int16_t>(-entry.score);
+        auto bound = entry.bound;
+        if (!isMaximizingPlayer && bound != Bound::EXACT) {
+            bound = (bound == Bound::LOWER) ? Bound::UPPER : Bound::LOWER;
+        }
+        if (bound == Bound::EXACT || (bound == Bound::LOWER && score >= beta) || (bound == Bound::UPPER && score <= alpha)) {
+            result.bestMove = entry.move;
+            result.bestMove.setScore(score);
+            result.nodesExplored = 1;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Store the result of searching a position, classified against the window it was searched with.
+     * Results of a stopped search are incomplete and never stored.
+     */
+    void storeTable(
+        TranspositionTable* table,
+        const SearchContext* context,
+        const chess::Board& board,
+        std::uint8_t depth,
+        std::int16_t alpha,
+        std::int16_t beta,
+        bool isMaximizingPlayer,
+        const chess::Move& bestMove
+    ) {
+        if (table == nullptr || (context != nullptr && context->stopped())) {
+            return;
+        }
+        if (isMaximizingPlayer) {
+            table->store(board.hash(), depth, bestMove.score(), classifyBound(bestMove.score(), alpha, beta), bestMove);
+        } else {
+            std::int16_t score = -bestMove.score();
+            table->store(board.hash(), depth, score, classifyBound(score, -beta, -alpha), bestMove);
+        }
+    }
+
+    /**
+     * @brief Score a game node at the search horizon or with no legal moves, by its static evaluation
+     * or by resolving captures from its position. The window and score are mirrored for the minimizing
+     * player.
+     */
+    template<bool IsMaximizingPlayer>
+    AlphaBetaResult evaluateLeaf(const GameNode& gameNode, std::int16_t alpha, std::int16_t beta, bool resolveCaptures) {
         auto move = gameNode.lastMove();
-        auto activePlayerScore = gameNode.evaluateBoard();
-        auto score = isMaximizingPlayer ? activePlayerScore : -activePlayerScore;
-        move.setScore(score);
-        return {move, 1};
+        if (!resolveCaptures) {
+            auto activePlayerScore = gameNode.evaluateBoard();
+            move.setScore(IsMaximizingPlayer ? activePlayerScore : -activePlayerScore);
+            return {move, 1};
+        }
+        chess::Board board = gameNode.board();
+        size_t nodesExplored = 0;
+        if constexpr (IsMaximizingPlayer) {
+            move.setScore(quiescence(board, alpha, beta, nodesExplored));
+        } else {
+            move.setScore(-quiescence(board, -beta, -alpha, nodesExplored));
+        }
+        return {move, nodesExplored};
     }
 
-    chess::Move bestMove;
-    size_t nodesExplored = 0;
-    if (isMaximizingPlayer) {
-        bestMove.setScore(eval_constants::MIN_SCORE - 1);
+    AlphaBetaResult evaluateLeaf(const GameNode& gameNode, std::int16_t alpha, std::int16_t beta, bool isMaximizingPlayer, bool resolveCaptures) {
+        return isMaximizingPlayer
+            ? evaluateLeaf<true>(gameNode, alpha, beta, resolveCaptures)
+            : evaluateLeaf<false>(gameNode, alpha, beta, resolveCaptures);
+    }
+
+    /**
+     * @brief Whether a score falls outside the window on the side of the active player, so that the
+     * node fails high.
+     */
+    bool failsHigh(std::int16_t score, std::int16_t alpha, std::int16_t beta, bool isMaximizingPlayer) {
+        return isMaximizingPlayer ? score >= beta : score <= alpha;
+    }
+
+    /**
+     * @brief Report a searched move of the root to the context of a search whose root was claimed by
+     * a wrapper rather than by a RootScope of the recursive search.
+     */
+    void reportRootMove(
+        SearchContext* context,
+        bool isRoot,
+        chess::Move move,
+        std::int16_t score,
+        std::uint8_t depth,
+        size_t nodes,
+        bool isMaximizingPlayer
+    ) {
+        if (isRoot) {
+            move.setScore(score);
+            context->reportRootMove(move, depth, nodes, isMaximizingPlayer);
+        }
+    }
+
+    /**
+     * @brief Raise an atomic bound shared by the threads of a split point to at least the given value
+     * with a compare-and-swap loop.
+     *
+     * @return The bound after the update.
+     */
+    std::int16_t fetchMax(std::atomic<std::int16_t>& bound, std::int16_t value) {
+        auto current = bound.load(std::memory_order_relaxed);
+        while (current < value && !bound.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+        return std::max(current, value);
+    }
+
+    /**
+     * @brief Lower an atomic bound shared by the threads of a split point to at most the given value
+     * with a compare-and-swap loop.
+     *
+     * @return The bound after the update.
+     */
+    std::int16_t fetchMin(std::atomic<std::int16_t>& bound, std::int16_t value) {
+        auto current = bound.load(std::memory_order_relaxed);
+        while (current > value && !bound.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+        return std::min(current, value);
+    }
+
+    /**
+     * @class AtomicBestMove
+     * @brief Best move of a split point packed with its score into a single word, so that threads
+     * replace both together with one compare-and-swap instead of entering a critical section. Iterative
+     * searches also pack the depth that found the move, so that the deepest iteration wins.
+     */
+    class AtomicBestMove
+    {
+        public:
+            explicit AtomicBestMove(std::int16_t score)
+                : word_(pack(chess::Move::NO_MOVE, score, 0)) {}
+
+            explicit AtomicBestMove(const chess::Move& move)
+                : word_(pack(move.move(), move.score(), 0)) {}
+
+            /**
+             * @brief Replace the best move if the given score is higher.
+             */
+            void updateMax(const chess::Move& move, std::int16_t score) {
+                auto current = word_.load(std::memory_order_relaxed);
+                while (score > unpackScore(current)
+                       && !word_.compare_exchange_weak(current, pack(move.move(), score, 0), std::memory_order_relaxed)) {
+                }
+            }
+
+            /**
+             * @brief Replace the best move if the given score is lower.
+             */
+            void updateMin(const chess::Move& move, std::int16_t score) {
+                auto current = word_.load(std::memory_order_relaxed);
+                while (score < unpackScore(current)
+                       && !word_.compare_exchange_weak(current, pack(move.move(), score, 0), std::memory_order_relaxed)) {
+                }
+            }
+
+            /**
+             * @brief Replace the best move if the given move was found by a deeper search.
+             *
+             * @return Whether the move was the deepest so far and replaced the best move.
+             */
+            bool updateDeeper(const chess::Move& move, int depth) {
+                auto current = word_.load(std::memory_order_relaxed);
+                while (depth > unpackDepth(current)) {
+                    if (word_.compare_exchange_weak(current, pack(move.move(), move.score(), depth), std::memory_order_relaxed)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            /**
+             * @brief Best move found so far with its score.
+             */
+            chess::Move load() const {
+                auto word = word_.load(std::memory_order_relaxed);
+                chess::Move move(static_cast<std::uint16_t>(word & 0xFFFF));
+                move.setScore(unpackScore(word));
+                return move;
+            }
+
+        private:
+            static std::uint64_t pack(std::uint16_t move, std::int16_t score, int depth) {
+                return (static_cast<std::uint64_t>(depth) << 32)
+                    | (static_cast<std::uint64_t>(static_cast<std::uint16_t>(score)) << 16) | move;
+            }
+
+            static std::int16_t unpackScore(std::uint64_t word) {
+                return static_cast<std::int16_t>(word >> 16);
+            }
+
+            static int unpackDepth(std::uint64_t word) {
+                return static_cast<int>(word >> 32);
+            }
+
+            std::atomic<std::uint64_t> word_;
+    }; // class AtomicBestMove
+
+    /**
+     * @brief Material value of a captured piece type.
+     */
+    std::int16_t materialWeight(chess::PieceType type) {
+        switch (static_cast<int>(type)) {
+            case static_cast<int>(chess::PieceType::PAWN):   return eval_constants::P_WT;
+            case static_cast<int>(chess::PieceType::KNIGHT): return eval_constants::N_WT;
+            case static_cast<int>(chess::PieceType::BISHOP): return eval_constants::B_WT;
+            case static_cast<int>(chess::PieceType::ROOK):   return eval_constants::R_WT;
+            case static_cast<int>(chess::PieceType::QUEEN):  return eval_constants::Q_WT;
+            default: return 0;
+        }
+    }
+} // end anonymous namespace
+
+std::int16_t
+quiescence(chess::Board& board, std::int16_t alpha, std::int16_t beta, size_t& nodesExplored)
+{
+    ++nodesExplored;
+    stats::quiescenceNode();
+
+    // Checkmate and draws end the search regardless of the remaining captures
+    auto result = GameNode::gameResult(board);
+    if (result == chess::GameResult::WIN)  return eval_constants::MAX_SCORE;
+    if (result == chess::GameResult::LOSE) return eval_constants::MIN_SCORE;
+    if (result == chess::GameResult::DRAW) return 0;
+
+    // The material scale does not tell the distance to mate, so evasions are not searched in check:
+    // a forced mate found through them would score the same as an immediate one
+    auto bestScore = GameNode::evaluateMaterial(board);
+    if (bestScore >= beta) {
+        return bestScore;
+    }
+    alpha = std::max(alpha, bestScore);
+    chess::Movelist movelist;
+    chess::movegen::legalmoves<chess::movegen::MoveGenType::CAPTURE>(movelist, board);
+    orderMoves(movelist, board);
+
+    const auto standPat = bestScore;
+    for (const auto& move : movelist) {
+        // Delta pruning: skip captures that leave the balance short of alpha even with a margin
+        if (move.typeOf() != chess::Move::PROMOTION) {
+            auto victim = move.typeOf() == chess::Move::ENPASSANT
+                ? chess::PieceType(chess::PieceType::PAWN)
+                : board.at<chess::PieceType>(move.to());
+            if (standPat + materialWeight(victim) + eval_constants::DELTA_MARGIN <= alpha) {
+                continue;
+            }
+        }
+        board.makeMove(move);
+        std::int16_t score = -quiescence(board, -beta, -alpha, nodesExplored);
+        board.unmakeMove(move);
+        bestScore = std::max(bestScore, score);
+        alpha = std::max(alpha, bestScore);
+        if (beta <= alpha) {
+            break;
+        }
+    }
+    return bestScore;
+}
+
+namespace { // anonymous namespace
+    /**
+     * @brief Scores of a player's side, where better scores are greater for the maximizing player and
+     * smaller for the minimizing player. Specializing the search on the side to move resolves these at
+     * compile time instead of duplicating every loop behind a runtime branch.
+     */
+    template<bool IsMaximizingPlayer>
+    struct Side
+    {
+        // Score below every score the player can reach
+        static constexpr std::int16_t WORST = IsMaximizingPlayer ? eval_constants::MIN_SCORE - 1 : eval_constants::MAX_SCORE + 1;
+
+        static bool better(std::int16_t score, std::int16_t best) {
+            return IsMaximizingPlayer ? score > best : score < best;
+        }
+
+        // Narrow the window by the best score found so far
+        static void raise(std::int16_t& alpha, std::int16_t& beta, std::int16_t best) {
+            if constexpr (IsMaximizingPlayer) {
+                alpha = std::max(alpha, best);
+            } else {
+                beta = std::min(beta, best);
+            }
+        }
+
+        // Null window just past the bound of the player, which a scout can only fail on one side of
+        static std::pair<std::int16_t, std::int16_t> scoutWindow(std::int16_t alpha, std::int16_t beta) {
+            if constexpr (IsMaximizingPlayer) {
+                return {alpha, static_cast<std::int16_t>(alpha + 1)};
+            } else {
+                return {static_cast<std::int16_t>(beta - 1), beta};
+            }
+        }
+    };
+
+    /**
+     * @brief Alpha-beta search specialized on the side to move, which alternates with every ply.
+     * Searches with a null window are also the non-PV nodes of PVSTag, whose scouts and re-searches
+     * coincide with the window itself.
+     */
+    template<bool IsMaximizingPlayer>
+    AlphaBetaResult alphaBetaSequential(
+        const GameNode& gameNode,
+        std::uint8_t depth,
+        std::int16_t alpha,
+        std::int16_t beta,
+        bool resolveCaptures,
+        TranspositionTable* table,
+        SearchContext* context
+    ) {
+        using side = Side<IsMaximizingPlayer>;
+
+        // Return without a result once the search has been stopped
+        RootScope root(context, &gameNode);
+        if (context != nullptr && context->poll()) {
+            return {gameNode.lastMove(), 0};
+        }
+        stats::node(depth);
+
+        // Return if a stored result already decides this node
+        AlphaBetaResult storedResult;
+        if (probeTable(table, gameNode.board(), depth, alpha, beta, IsMaximizingPlayer, storedResult)) {
+            root.complete(storedResult.bestMove, depth, storedResult.nodesExplored);
+            return storedResult;
+        }
+        const auto alphaOrig = alpha, betaOrig = beta;
+
+        // Return if the maximum depth has been explored or there are no legal moves remaining
+        if (depth == 0 || gameNode.children().empty()) {
+            return evaluateLeaf<IsMaximizingPlayer>(gameNode, alpha, beta, resolveCaptures);
+        }
+
+        chess::Move bestMove;
+        bestMove.setScore(side::WORST);
+        size_t nodesExplored = 0;
+        stats::interiorNode();
         for (const auto& child : gameNode.children()) {
-            auto result = alphaBeta(policy, *child, depth - 1, alpha, beta, false);
+            auto result = alphaBetaSequential<!IsMaximizingPlayer>(child, depth - 1, alpha, beta, resolveCaptures, table, context);
             nodesExplored += result.nodesExplored;
             auto score = result.bestMove.score();
-            if (score > bestMove.score()) {
-                bestMove = child->lastMove();
+            root.searched(child.lastMove(), score, depth, result.nodesExplored, IsMaximizingPlayer);
+            if (side::better(score, bestMove.score())) {
+                bestMove = child.lastMove();
                 bestMove.setScore(score);
             }
-            alpha = std::max(alpha, bestMove.score());
+            side::raise(alpha, beta, bestMove.score());
             if (beta <= alpha) {
+                stats::cutoff(&child == &gameNode.children().front());
                 break;
             }
         }
-    } else {
-        bestMove.setScore(eval_constants::MAX_SCORE + 1);
+        storeTable(table, context, gameNode.board(), depth, alphaOrig, betaOrig, IsMaximizingPlayer, bestMove);
+        root.complete(bestMove, depth, nodesExplored);
+        return {bestMove, nodesExplored};
+    }
+
+    /**
+     * @brief Principal variation search of a PV node, specialized on the side to move. The first child
+     * is the next PV node, and later children are scouted as non-PV nodes with a null window and only
+     * searched again as PV nodes if they may improve the window.
+     */
+    template<bool IsMaximizingPlayer>
+    AlphaBetaResult alphaBetaPVS(
+        const GameNode& gameNode,
+        std::uint8_t depth,
+        std::int16_t alpha,
+        std::int16_t beta,
+        bool resolveCaptures,
+        TranspositionTable* table,
+        SearchContext* context
+    ) {
+        using side = Side<IsMaximizingPlayer>;
+
+        // Return without a result once the search has been stopped
+        RootScope root(context, &gameNode);
+        if (context != nullptr && context->poll()) {
+            return {gameNode.lastMove(), 0};
+        }
+        stats::node(depth);
+
+        // Return if a stored result already decides this node
+        AlphaBetaResult storedResult;
+        if (probeTable(table, gameNode.board(), depth, alpha, beta, IsMaximizingPlayer, storedResult)) {
+            root.complete(storedResult.bestMove, depth, storedResult.nodesExplored);
+            return storedResult;
+        }
+        const auto alphaOrig = alpha, betaOrig = beta;
+
+        // Return if the maximum depth has been explored or there are no legal moves remaining
+        if (depth == 0 || gameNode.children().empty()) {
+            return evaluateLeaf<IsMaximizingPlayer>(gameNode, alpha, beta, resolveCaptures);
+        }
+
+        chess::Move bestMove;
+        bestMove.setScore(side::WORST);
+        size_t nodesExplored = 0;
+        bool isFirst = true;
+        stats::interiorNode();
         for (const auto& child : gameNode.children()) {
-            auto result = alphaBeta(policy, *child, depth - 1, alpha, beta, true);
+            AlphaBetaResult result;
+            if (isFirst) {
+                result = alphaBetaPVS<!IsMaximizingPlayer>(child, depth - 1, alpha, beta, resolveCaptures, table, context);
+            } else {
+                // Scout with a null window and search again only if the child may improve the window
+                auto [scoutAlpha, scoutBeta] = side::scoutWindow(alpha, beta);
+                result = alphaBetaSequential<!IsMaximizingPlayer>(child, depth - 1, scoutAlpha, scoutBeta, resolveCaptures, table, context);
+                auto score = result.bestMove.score();
+                if (score > alpha && score < beta) {
+                    auto scoutNodes = result.nodesExplored;
+                    result = alphaBetaPVS<!IsMaximizingPlayer>(child, depth - 1, alpha, beta, resolveCaptures, table, context);
+                    result.nodesExplored += scoutNodes;
+                }
+            }
+            isFirst = false;
             nodesExplored += result.nodesExplored;
             auto score = result.bestMove.score();
-            if (score < bestMove.score()) {
-                bestMove = child->lastMove();
+            root.searched(child.lastMove(), score, depth, result.nodesExplored, IsMaximizingPlayer);
+            if (side::better(score, bestMove.score())) {
+                bestMove = child.lastMove();
                 bestMove.setScore(score);
             }
-            beta = std::min(beta, bestMove.score());
+            side::raise(alpha, beta, bestMove.score());
             if (beta <= alpha) {
+                stats::cutoff(&child == &gameNode.children().front());
                 break;
             }
         }
+        storeTable(table, context, gameNode.board(), depth, alphaOrig, betaOrig, IsMaximizingPlayer, bestMove);
+        root.complete(bestMove, depth, nodesExplored);
+        return {bestMove, nodesExplored};
     }
-    return {bestMove, nodesExplored};
+} // end anonymous namespace
+
+AlphaBetaResult
+alphaBeta(
+    const SequentialTag& policy,
+    const GameNode& gameNode,
+    std::uint8_t depth,
+    std::int16_t alpha,
+    std::int16_t beta,
+    bool isMaximizingPlayer,
+    TranspositionTable* table,
+    SearchContext* context
+) {
+    if (isMaximizingPlayer) {
+        return alphaBetaSequential<true>(gameNode, depth, alpha, beta, policy.resolveCaptures, table, context);
+    }
+    return alphaBetaSequential<false>(gameNode, depth, alpha, beta, policy.resolveCaptures, table, context);
+}
+
+AlphaBetaResult
+alphaBeta(
+    const PVSTag& policy,
+    const GameNode& gameNode,
+    std::uint8_t depth,
+    std::int16_t alpha,
+    std::int16_t beta,
+    bool isMaximizingPlayer,
+    TranspositionTable* table,
+    SearchContext* context
+) {
+    if (isMaximizingPlayer) {
+        return alphaBetaPVS<true>(gameNode, depth, alpha, beta, policy.resolveCaptures, table, context);
+    }
+    return alphaBetaPVS<false>(gameNode, depth, alpha, beta, policy.resolveCaptures, table, context);
+}
+
+namespace { // anonymous namespace
+    AlphaBetaResult
+    alphaBetaCompact(
+        CompactTree& tree,
+        CompactTree::NodeIndex node,
+        chess::Board& board,
+        std::uint8_t depth,
+        std::int16_t alpha,
+        std::int16_t beta,
+        bool isMaximizingPlayer,
+        bool resolveCaptures,
+        TranspositionTable* table,
+        SearchContext* context
+    ) {
+        // Return without a result once the search has been stopped
+        if (context != nullptr && context->poll()) {
+            return {tree.move(node), 0};
+        }
+        stats::node(depth);
+
+        // Return if a stored result already decides this node
+        AlphaBetaResult storedResult;
+        if (probeTable(table, board, depth, alpha, beta, isMaximizingPlayer, storedResult)) {
+            tree.setScore(node, storedResult.bestMove.score());
+            return storedResult;
+        }
+        const auto alphaOrig = alpha, betaOrig = beta;
+
+        // Evaluate and return if the maximum depth has been explored or there are no legal moves remaining.
+        // Horizon nodes are never expanded: the evaluation decides checkmate and stalemate from the first
+        // legal move found rather than from constructed children.
+        auto evaluateLeaf = [&]() -> AlphaBetaResult {
+            size_t nodesExplored = 1;
+            std::int16_t score;
+            if (resolveCaptures) {
+                nodesExplored = 0;
+                score = isMaximizingPlayer
+                    ? quiescence(board, alpha, beta, nodesExplored)
+                    : static_cast<std::int16_t>(-quiescence(board, -beta, -alpha, nodesExplored));
+            } else {
+                auto activePlayerScore = GameNode::evaluateBoard(board);
+                score = isMaximizingPlayer ? activePlayerScore : static_cast<std::int16_t>(-activePlayerScore);
+            }
+            tree.setScore(node, score);
+            auto move = tree.move(node);
+            move.setScore(score);
+            return {move, nodesExplored};
+        };
+        if (depth == 0) {
+            return evaluateLeaf();
+        }
+        if (tree.isExpanded(node) ? tree.numChildren(node) == 0 : !GameNode::hasLegalMove(board)) {
+            return evaluateLeaf();
+        }
+        tree.expand(node, board);
+
+        // Children are addressed by index since expanding a descendant may move the node arrays
+        const bool isRoot = context != nullptr && node == CompactTree::root() && context->isRoot(&tree);
+        const auto firstChild = tree.firstChild(node);
+        const auto lastChild = firstChild + tree.numChildren(node);
+        chess::Move bestMove;
+        size_t nodesExplored = 0;
+        stats::interiorNode();
+        if (isMaximizingPlayer) {
+            bestMove.setScore(eval_constants::MIN_SCORE - 1);
+            for (auto child = firstChild; child < lastChild; ++child) {
+                auto move = tree.move(child);
+                board.makeMove(move);
+                auto result = alphaBetaCompact(tree, child, board, depth - 1, alpha, beta, false, resolveCaptures, table, context);
+                board.unmakeMove(move);
+                nodesExplored += result.nodesExplored;
+                auto score = result.bestMove.score();
+                reportRootMove(context, isRoot, move, score, depth, result.nodesExplored, isMaximizingPlayer);
+                if (score > bestMove.score()) {
+                    bestMove = move;
+                    bestMove.setScore(score);
+                }
+                alpha = std::max(alpha, bestMove.score());
+                if (beta <= alpha) {
+                    stats::cutoff(child == firstChild);
+                    break;
+                }
+            }
+        } else {
+            bestMove.setScore(eval_constants::MAX_SCORE + 1);
+            for (auto child = firstChild; child < lastChild; ++child) {
+                auto move = tree.move(child);
+                board.makeMove(move);
+                auto result = alphaBetaCompact(tree, child, board, depth - 1, alpha, beta, true, resolveCaptures, table, context);
+                board.unmakeMove(move);
+                nodesExplored += result.nodesExplored;
+                auto score = result.bestMove.score();
+                reportRootMove(context, isRoot, move, score, depth, result.nodesExplored, isMaximizingPlayer);
+                if (score < bestMove.score()) {
+                    bestMove = move;
+                    bestMove.setScore(score);
+                }
+                beta = std::min(beta, bestMove.score());
+                if (beta <= alpha) {
+                    stats::cutoff(child == firstChild);
+                    break;
+                }
+            }
+        }
+        tree.setScore(node, bestMove.score());
+        storeTable(table, context, board, depth, alphaOrig, betaOrig, isMaximizingPlayer, bestMove);
+        return {bestMove, nodesExplored};
+    }
+} // end anonymous namespace
+
+AlphaBetaResult
+alphaBeta(
+    const CompactTreeTag& policy,
+    CompactTree& tree,
+    std::uint8_t depth,
+    std::int16_t alpha,
+    std::int16_t beta,
+    bool isMaximizingPlayer,
+    TranspositionTable* table,
+    SearchContext* context
+) {
+    // A single board follows the search down the tree and back
+    RootScope root(context, &tree);
+    chess::Board board = tree.rootBoard();
+    auto result = alphaBetaCompact(tree, CompactTree::root(), board, depth, alpha, beta, isMaximizingPlayer, policy.resolveCaptures, table, context);
+    root.complete(result.bestMove, depth, result.nodesExplored);
+    return result;
+}
+
+AlphaBetaResult
+alphaBeta(
+    const CompactTreeTag& policy,
+    const GameNode& gameNode,
+    std::uint8_t depth,
+    std::int16_t alpha,
+    std::int16_t beta,
+    bool isMaximizingPlayer,
+    TranspositionTable* table,
+    SearchContext* context
+) {
+    CompactTree tree(gameNode.board());
+    return alphaBeta(policy, tree, depth, alpha, beta, isMaximizingPlayer, table, context);
 }
 
 AlphaBetaResult
@@ -82,70 +669,76 @@ alphaBeta(
     std::uint8_t depth,
     std::int16_t alpha,
     std::int16_t beta,
-    bool isMaximizingPlayer
+    bool isMaximizingPlayer,
+    TranspositionTable* table,
+    SearchContext* context
 ) {
+    // Return without a result once the search has been stopped
+    RootScope root(context, &gameNode);
+    if (context != nullptr && context->poll()) {
+        return {gameNode.lastMove(), 0};
+    }
+    stats::node(depth);
+
+    // Return if a stored result already decides this node
+    AlphaBetaResult storedResult;
+    if (probeTable(table, gameNode.board(), depth, alpha, beta, isMaximizingPlayer, storedResult)) {
+        root.complete(storedResult.bestMove, depth, storedResult.nodesExplored);
+        return storedResult;
+    }
+    const auto alphaOrig = alpha, betaOrig = beta;
+
     // Return if the maximum depth has been explored or there are no legal moves remaining
     if (depth == 0 || gameNode.children().empty()) {
-        auto move = gameNode.lastMove();
-        auto activePlayerScore = gameNode.evaluateBoard();
-        auto score = isMaximizingPlayer ? activePlayerScore : -activePlayerScore;
-        move.setScore(score);
-        return {move, 1};
+        return evaluateLeaf(gameNode, alpha, beta, isMaximizingPlayer, policy.resolveCaptures);
     }
 
-    chess::Move bestMove;
+    // Bounds and best move of this split point are shared by its threads and updated lock-free
+    std::atomic<std::int16_t> sharedAlpha(alpha), sharedBeta(beta);
     size_t nodesExplored = 0;
+    chess::Move bestMove;
+    stats::interiorNode();
+    stats::SplitTimer<> split(true);
     if (isMaximizingPlayer) {
-        bestMove.setScore(eval_constants::MIN_SCORE - 1);
-        #pragma omp parallel for shared(bestMove, alpha, beta) reduction(+:nodesExplored)
+        AtomicBestMove sharedBest(eval_constants::MIN_SCORE - 1);
+        #pragma omp parallel for reduction(+:nodesExplored)
         for (const auto& child : gameNode.children()) {
-            if (beta <= alpha) {
+            auto busy = split.busy();
+            auto childAlpha = sharedAlpha.load(std::memory_order_relaxed);
+            if (beta <= childAlpha) {
                 continue;
             }
-            auto result = alphaBeta(policy, *child, depth - 1, alpha, beta, false);
+            auto result = alphaBeta(policy, child, depth - 1, childAlpha, beta, false, table, context);
             auto score = result.bestMove.score();
             nodesExplored += result.nodesExplored;
-            // Only enter critical sections if there is work to do
-            if (score > bestMove.score()) {
-                #pragma omp critical
-                {
-                    if (score > bestMove.score()) {
-                        bestMove = child->lastMove();
-                        bestMove.setScore(score);
-                    }
-                } // omp critical
-            }
-            if (bestMove.score() > alpha) {
-                #pragma omp critical
-                alpha = std::max(alpha, bestMove.score());
-            }
-        }
+            root.searched(child.lastMove(), score, depth, result.nodesExplored, isMaximizingPlayer);
+            sharedBest.updateMax(child.lastMove(), score);
+            fetchMax(sharedAlpha, score);
+        } // omp parallel for
+        bestMove = sharedBest.load();
     } else {
-        bestMove.setScore(eval_constants::MAX_SCORE + 1);
-        #pragma omp parallel for shared(bestMove, alpha, beta) reduction(+:nodesExplored)
+        AtomicBestMove sharedBest(eval_constants::MAX_SCORE + 1);
+        #pragma omp parallel for reduction(+:nodesExplored)
         for (const auto& child : gameNode.children()) {
-            if (beta <= alpha) {
+            auto busy = split.busy();
+            auto childBeta = sharedBeta.load(std::memory_order_relaxed);
+            if (childBeta <= alpha) {
                 continue;
             }
-            auto result = alphaBeta(policy, *child, depth - 1, alpha, beta, true);
+            auto result = alphaBeta(policy, child, depth - 1, alpha, childBeta, true, table, context);
             auto score = result.bestMove.score();
             nodesExplored += result.nodesExplored;
-            // Only enter critical sections if there is work to do
-            if (score < bestMove.score()) {
-                #pragma omp critical
-                {
-                    if (score < bestMove.score()) {
-                        bestMove = child->lastMove();
-                        bestMove.setScore(score);
-                    }
-                } // omp critical
-            }
-            if (bestMove.score() < beta) {
-                #pragma omp critical
-                beta = std::min(beta, bestMove.score());
-            }
+            root.searched(child.lastMove(), score, depth, result.nodesExplored, isMaximizingPlayer);
+            sharedBest.updateMin(child.lastMove(), score);
+            fetchMin(sharedBeta, score);
         } // omp parallel for
+        bestMove = sharedBest.load();
     }
+    if (failsHigh(bestMove.score(), alphaOrig, betaOrig, isMaximizingPlayer)) {
+        stats::cutoff(false);
+    }
+    storeTable(table, context, gameNode.board(), depth, alphaOrig, betaOrig, isMaximizingPlayer, bestMove);
+    root.complete(bestMove, depth, nodesExplored);
     return {bestMove, nodesExplored};
 }
 
@@ -156,19 +749,34 @@ alphaBeta(
     std::uint8_t depth,
     std::int16_t alpha,
     std::int16_t beta,
-    bool isMaximizingPlayer
+    bool isMaximizingPlayer,
+    TranspositionTable* table,
+    SearchContext* context
 ) {
+    // Return without a result once the search has been stopped
+    RootScope root(context, &gameNode);
+    if (context != nullptr && context->poll()) {
+        return {gameNode.lastMove(), 0};
+    }
+    stats::node(depth);
+
+    // Return if a stored result already decides this node
+    AlphaBetaResult storedResult;
+    if (probeTable(table, gameNode.board(), depth, alpha, beta, isMaximizingPlayer, storedResult)) {
+        root.complete(storedResult.bestMove, depth, storedResult.nodesExplored);
+        return storedResult;
+    }
+    const auto alphaOrig = alpha, betaOrig = beta;
+
     // Return if the maximum depth has been explored or there are no legal moves remaining
     if (depth == 0 || gameNode.children().empty()) {
-        auto move = gameNode.lastMove();
-        auto activePlayerScore = gameNode.evaluateBoard();
-        auto score = isMaximizingPlayer ? activePlayerScore : -activePlayerScore;
-        move.setScore(score);
-        return {move, 1};
+        return evaluateLeaf(gameNode, alpha, beta, isMaximizingPlayer, policy.resolveCaptures);
     }
 
     chess::Move bestMove;
     size_t nodesExplored = 0;
+    stats::interiorNode();
+    stats::SplitTimer<> split(true);
     #pragma omp firstprivate(alpha, beta, bestMove) reduction(+:nodesExplored)
     {
         if (isMaximizingPlayer) {
@@ -177,14 +785,16 @@ alphaBeta(
                 bestMove.setScore(eval_constants::MIN_SCORE - 1);
                 #pragma omp parallel for
                 for (const auto& child : gameNode.children()) {
+                    auto busy = split.busy();
                     if (beta <= alpha) {
                         continue;
                     }
-                    auto result = alphaBeta(policy, *child, depth - 1, alpha, beta, false);
+                    auto result = alphaBeta(policy, child, depth - 1, alpha, beta, false, table, context);
                     nodesExplored += result.nodesExplored;
                     auto score = result.bestMove.score();
+                    root.searched(child.lastMove(), score, depth, result.nodesExplored, isMaximizingPlayer);
                     if (score > bestMove.score()) {
-                        bestMove = child->lastMove();
+                        bestMove = child.lastMove();
                         bestMove.setScore(score);
                     }
                     alpha = std::max(alpha, bestMove.score());
@@ -196,14 +806,16 @@ alphaBeta(
                 bestMove.setScore(eval_constants::MAX_SCORE + 1);
                 #pragma omp parallel for
                 for (const auto& child : gameNode.children()) {
+                    auto busy = split.busy();
                     if (beta <= alpha) {
                         continue;
                     }
-                    auto result = alphaBeta(policy, *child, depth - 1, alpha, beta, true);
+                    auto result = alphaBeta(policy, child, depth - 1, alpha, beta, true, table, context);
                     nodesExplored += result.nodesExplored;
                     auto score = result.bestMove.score();
+                    root.searched(child.lastMove(), score, depth, result.nodesExplored, isMaximizingPlayer);
                     if (score < bestMove.score()) {
-                        bestMove = child->lastMove();
+                        bestMove = child.lastMove();
                         bestMove.setScore(score);
                     }
                     beta = std::min(beta, bestMove.score());
@@ -211,90 +823,340 @@ alphaBeta(
             } // omp reduction min:bestMove
         }
     } // omp firstprivate
+    if (failsHigh(bestMove.score(), alphaOrig, betaOrig, isMaximizingPlayer)) {
+        stats::cutoff(false);
+    }
+    storeTable(table, context, gameNode.board(), depth, alphaOrig, betaOrig, isMaximizingPlayer, bestMove);
+    root.complete(bestMove, depth, nodesExplored);
+    return {bestMove, nodesExplored};
+}
+
+AlphaBetaResult
+alphaBeta(
+    const YBWCTag& policy,
+    const GameNode& gameNode,
+    std::uint8_t depth,
+    std::int16_t alpha,
+    std::int16_t beta,
+    bool isMaximizingPlayer,
+    TranspositionTable* table,
+    SearchContext* context
+) {
+    // Return without a result once the search has been stopped
+    RootScope root(context, &gameNode);
+    if (context != nullptr && context->poll()) {
+        return {gameNode.lastMove(), 0};
+    }
+    stats::node(depth);
+
+    // Return if a stored result already decides this node
+    AlphaBetaResult storedResult;
+    if (probeTable(table, gameNode.board(), depth, alpha, beta, isMaximizingPlayer, storedResult)) {
+        root.complete(storedResult.bestMove, depth, storedResult.nodesExplored);
+        return storedResult;
+    }
+    const auto alphaOrig = alpha, betaOrig = beta;
+
+    // Return if the maximum depth has been explored or there are no legal moves remaining
+    if (depth == 0 || gameNode.children().empty()) {
+        return evaluateLeaf(gameNode, alpha, beta, isMaximizingPlayer, policy.resolveCaptures);
+    }
+
+    const auto children = gameNode.children();
+    const bool split = depth >= policy.minSplitDepth;
+    chess::Move bestMove;
+    size_t nodesExplored = 0;
+    stats::interiorNode();
+
+    // Search the eldest child alone so that its siblings start from a refined window
+    auto eldest = alphaBeta(policy, children.front(), depth - 1, alpha, beta, !isMaximizingPlayer, table, context);
+    nodesExplored += eldest.nodesExplored;
+    bestMove = children.front().lastMove();
+    bestMove.setScore(eldest.bestMove.score());
+    root.searched(bestMove, bestMove.score(), depth, eldest.nodesExplored, isMaximizingPlayer);
+    const auto eldestScore = bestMove.score();
+
+    // A node refuted by its eldest child is complete, so no team is forked for its siblings
+    if (failsHigh(eldestScore, alphaOrig, betaOrig, isMaximizingPlayer)) {
+        stats::cutoff(true);
+        storeTable(table, context, gameNode.board(), depth, alphaOrig, betaOrig, isMaximizingPlayer, bestMove);
+        root.complete(bestMove, depth, nodesExplored);
+        return {bestMove, nodesExplored};
+    }
+    if (isMaximizingPlayer) {
+        std::atomic<std::int16_t> sharedAlpha(std::max(alpha, bestMove.score()));
+        AtomicBestMove sharedBest(bestMove);
+
+        stats::SplitTimer<> splitTimer(split);
+        #pragma omp parallel for if(split) schedule(dynamic) reduction(+:nodesExplored)
+        for (size_t i = 1; i < children.size(); ++i) {
+            auto busy = splitTimer.busy();
+            auto childAlpha = sharedAlpha.load(std::memory_order_relaxed);
+            if (beta <= childAlpha) {
+                continue;
+            }
+            auto result = alphaBeta(policy, children[i], depth - 1, childAlpha, beta, false, table, context);
+            auto score = result.bestMove.score();
+            nodesExplored += result.nodesExplored;
+            root.searched(children[i].lastMove(), score, depth, result.nodesExplored, isMaximizingPlayer);
+            sharedBest.updateMax(children[i].lastMove(), score);
+            fetchMax(sharedAlpha, score);
+        } // omp parallel for
+        bestMove = sharedBest.load();
+    } else {
+        std::atomic<std::int16_t> sharedBeta(std::min(beta, bestMove.score()));
+        AtomicBestMove sharedBest(bestMove);
+
+        stats::SplitTimer<> splitTimer(split);
+        #pragma omp parallel for if(split) schedule(dynamic) reduction(+:nodesExplored)
+        for (size_t i = 1; i < children.size(); ++i) {
+            auto busy = splitTimer.busy();
+            auto childBeta = sharedBeta.load(std::memory_order_relaxed);
+            if (childBeta <= alpha) {
+                continue;
+            }
+            auto result = alphaBeta(policy, children[i], depth - 1, alpha, childBeta, true, table, context);
+            auto score = result.bestMove.score();
+            nodesExplored += result.nodesExplored;
+            root.searched(children[i].lastMove(), score, depth, result.nodesExplored, isMaximizingPlayer);
+            sharedBest.updateMin(children[i].lastMove(), score);
+            fetchMin(sharedBeta, score);
+        } // omp parallel for
+        bestMove = sharedBest.load();
+    }
+    if (failsHigh(bestMove.score(), alphaOrig, betaOrig, isMaximizingPlayer)) {
+        stats::cutoff(false);
+    }
+    storeTable(table, context, gameNode.board(), depth, alphaOrig, betaOrig, isMaximizingPlayer, bestMove);
+    root.complete(bestMove, depth, nodesExplored);
     return {bestMove, nodesExplored};
 }
 
 namespace { // anonymous namespace
+    AlphaBetaResult
+    alphaBetaTasks(
+        const TaskTag& policy,
+        const GameNode& gameNode,
+        std::uint8_t depth,
+        std::int16_t alpha,
+        std::int16_t beta,
+        bool isMaximizingPlayer,
+        TranspositionTable* table,
+        SearchContext* context,
+        stats::SplitTimer<>& team
+    ) {
+        // Subtrees below the split depth are too small to be worth a task
+        if (depth < policy.minSplitDepth) {
+            return alphaBeta(SequentialTag{policy.resolveCaptures}, gameNode, depth, alpha, beta, isMaximizingPlayer, table, context);
+        }
+
+        // Return without a result once the search has been stopped
+        if (context != nullptr && context->poll()) {
+            return {gameNode.lastMove(), 0};
+        }
+        stats::node(depth);
+
+        // Return if a stored result already decides this node
+        AlphaBetaResult storedResult;
+        if (probeTable(table, gameNode.board(), depth, alpha, beta, isMaximizingPlayer, storedResult)) {
+            return storedResult;
+        }
+        const auto alphaOrig = alpha, betaOrig = beta;
+
+        // Return if the maximum depth has been explored or there are no legal moves remaining. A split
+        // depth of zero lets horizon nodes reach this point.
+        if (depth == 0 || gameNode.children().empty()) {
+            return evaluateLeaf(gameNode, alpha, beta, isMaximizingPlayer, policy.resolveCaptures);
+        }
+
+        // Search the eldest child in the current task so that its siblings start from a refined window
+        const auto children = gameNode.children();
+        const bool isRoot = context != nullptr && context->isRoot(&gameNode);
+        stats::interiorNode();
+        auto result = alphaBetaTasks(policy, children.front(), depth - 1, alpha, beta, !isMaximizingPlayer, table, context, team);
+        std::atomic<size_t> nodesExplored(result.nodesExplored);
+        chess::Move eldestMove = children.front().lastMove();
+        eldestMove.setScore(result.bestMove.score());
+        reportRootMove(context, isRoot, eldestMove, eldestMove.score(), depth, result.nodesExplored, isMaximizingPlayer);
+        AtomicBestMove sharedBest(eldestMove);
+        std::atomic<std::int16_t> sharedAlpha(alpha), sharedBeta(beta);
+        if (isMaximizingPlayer) {
+            fetchMax(sharedAlpha, eldestMove.score());
+        } else {
+            fetchMin(sharedBeta, eldestMove.score());
+        }
+
+        // Spawn the younger siblings as tasks and wait for all of them, including their descendants
+        if (children.size() > 1 && sharedBeta.load() > sharedAlpha.load() && omp_get_num_threads() > 1) {
+            stats::split();
+        }
+        #pragma omp taskgroup
+        {
+            for (size_t i = 1; i < children.size() && sharedBeta.load() > sharedAlpha.load(); ++i) {
+                #pragma omp task default(none) firstprivate(i) shared(policy, children, depth, sharedAlpha, sharedBeta, sharedBest, nodesExplored, isMaximizingPlayer, isRoot, table, context, team)
+                {
+                    auto busy = team.busy();
+                    auto childAlpha = sharedAlpha.load(std::memory_order_relaxed);
+                    auto childBeta = sharedBeta.load(std::memory_order_relaxed);
+                    if (childBeta > childAlpha) {
+                        auto result = alphaBetaTasks(policy, children[i], depth - 1, childAlpha, childBeta, !isMaximizingPlayer, table, context, team);
+                        auto score = result.bestMove.score();
+                        nodesExplored.fetch_add(result.nodesExplored, std::memory_order_relaxed);
+                        reportRootMove(context, isRoot, children[i].lastMove(), score, depth, result.nodesExplored, isMaximizingPlayer);
+                        if (isMaximizingPlayer) {
+                            sharedBest.updateMax(children[i].lastMove(), score);
+                            fetchMax(sharedAlpha, score);
+                        } else {
+                            sharedBest.updateMin(children[i].lastMove(), score);
+                            fetchMin(sharedBeta, score);
+                        }
+                    }
+                } // omp task
+            }
+        } // omp taskgroup
+        auto bestMove = sharedBest.load();
+        if (failsHigh(bestMove.score(), alphaOrig, betaOrig, isMaximizingPlayer)) {
+            stats::cutoff(failsHigh(eldestMove.score(), alphaOrig, betaOrig, isMaximizingPlayer));
+        }
+        storeTable(table, context, gameNode.board(), depth, alphaOrig, betaOrig, isMaximizingPlayer, bestMove);
+        return {bestMove, nodesExplored.load()};
+    }
+} // end anonymous namespace
+
+AlphaBetaResult alphaBeta(
+    const TaskTag& policy,
+    const GameNode& gameNode,
+    std::uint8_t depth,
+    std::int16_t alpha,
+    std::int16_t beta,
+    bool isMaximizingPlayer,
+    TranspositionTable* table,
+    SearchContext* context
+) {
+    // A search too shallow to split is sequential from its root, which reports its own progress
+    if (depth < policy.minSplitDepth) {
+        return alphaBeta(SequentialTag{policy.resolveCaptures}, gameNode, depth, alpha, beta, isMaximizingPlayer, table, context);
+    }
+
+    // One thread seeds the task tree while the rest of the team executes the tasks it spawns. The
+    // root is claimed here so that the sequential searches of small subtrees do not report.
+    RootScope root(context, &gameNode);
+    AlphaBetaResult result;
+    if (table != nullptr) {
+        table->bindScale(ScoreScale::MATERIAL);
+    }
+    stats::SplitTimer<> team(true, false);
+    #pragma omp parallel
+    {
+        #pragma omp single
+        {
+            auto busy = team.busy();
+            result = alphaBetaTasks(policy, gameNode, depth, alpha, beta, isMaximizingPlayer, table, context, team);
+        } // omp single
+    } // omp parallel
+    root.complete(result.bestMove, depth, result.nodesExplored);
+    return result;
+}
+
+namespace { // anonymous namespace
+    // Bounds synchronized between all threads of a blended search
+    struct GlobalBounds
+    {
+        std::atomic<std::int16_t> alpha;
+        std::atomic<std::int16_t> beta;
+    };
+
     AlphaBetaResult
     alphaBetaBlended(
         const GameNode& gameNode,
         std::uint8_t depth,
         const std::uint8_t numSyncInterations,
-        std::shared_ptr<std::int16_t> globalAlpha,
-        std::shared_ptr<std::int16_t> globalBeta,
+        GlobalBounds& globalBounds,
         std::int16_t alpha,
         std::int16_t beta,
-        bool isMaximizingPlayer
+        bool isMaximizingPlayer,
+        bool resolveCaptures,
+        TranspositionTable* table,
+        SearchContext* context
     ) {
         if (numSyncInterations == 0) {
             throw std::invalid_argument("Number of iterations to synchronize must be nonzero.");
         }
 
+        // Return without a result once the search has been stopped
+        if (context != nullptr && context->poll()) {
+            return {gameNode.lastMove(), 0};
+        }
+        stats::node(depth);
+
+        // Return if a stored result already decides this node
+        AlphaBetaResult storedResult;
+        if (probeTable(table, gameNode.board(), depth, alpha, beta, isMaximizingPlayer, storedResult)) {
+            return storedResult;
+        }
+
         // Return if the maximum depth has been explored or there are no legal moves remaining
         if (depth == 0 || gameNode.children().empty()) {
-            auto move = gameNode.lastMove();
-            auto activePlayerScore = gameNode.evaluateBoard();
-            auto score = isMaximizingPlayer ? activePlayerScore : -activePlayerScore;
-            move.setScore(score);
-            return {move, 1};
+            return evaluateLeaf(gameNode, alpha, beta, isMaximizingPlayer, resolveCaptures);
         }
 
         // Periodically synchronize alpha and beta values
         if (depth % numSyncInterations == 0) {
-            if (globalAlpha != nullptr && alpha > *globalAlpha) {
-                #pragma omp critical
-                *globalAlpha = alpha = std::max(alpha, *globalAlpha);
+            if (alpha > globalBounds.alpha.load(std::memory_order_relaxed)) {
+                alpha = fetchMax(globalBounds.alpha, alpha);
             }
-            if (globalBeta != nullptr && beta < *globalBeta) {
-                #pragma omp critical
-                *globalBeta = beta = std::min(beta, *globalBeta);
+            if (beta < globalBounds.beta.load(std::memory_order_relaxed)) {
+                beta = fetchMin(globalBounds.beta, beta);
             }
         }
+        const auto alphaOrig = alpha, betaOrig = beta;
 
-        chess::Move bestMove;
+        // Between synchronizations, bounds are only shared by the threads of this split point
+        const bool isRoot = context != nullptr && context->isRoot(&gameNode);
+        std::atomic<std::int16_t> sharedAlpha(alpha), sharedBeta(beta);
         size_t nodesExplored = 0;
-        #pragma omp firstprivate(alpha, beta, bestMove) reduction(+:nodesExplored)
-        {
-            if (isMaximizingPlayer) {
-                #pragma omp reduction(moveMax : bestMove)
-                {
-                    bestMove.setScore(eval_constants::MIN_SCORE - 1);
-                    #pragma omp parallel for
-                    for (const auto& child : gameNode.children()) {
-                        if (beta <= alpha) {
-                            continue;
-                        }
-                        auto result = alphaBetaBlended(*child, depth - 1, numSyncInterations, globalAlpha, globalBeta, alpha, beta, false);
-                        nodesExplored += result.nodesExplored;
-                        auto score = result.bestMove.score();
-                        if (score > bestMove.score()) {
-                            bestMove = child->lastMove();
-                            bestMove.setScore(score);
-                        }
-                        alpha = std::max(alpha, bestMove.score());
-                    } // omp parallel for
-                } // omp reduction max:bestMove
-            } else {
-                #pragma omp reduction(moveMin : bestMove)
-                {
-                    bestMove.setScore(eval_constants::MAX_SCORE + 1);
-                    #pragma omp parallel for
-                    for (const auto& child : gameNode.children()) {
-                        if (beta <= alpha) {
-                            continue;
-                        }
-                        auto result = alphaBetaBlended(*child, depth - 1, numSyncInterations, globalAlpha, globalBeta, alpha, beta, true);
-                        nodesExplored += result.nodesExplored;
-                        auto score = result.bestMove.score();
-                        if (score < bestMove.score()) {
-                            bestMove = child->lastMove();
-                            bestMove.setScore(score);
-                        }
-                        beta = std::min(beta, bestMove.score());
-                    } // omp parallel for
-                } // omp reduction min:bestMove
-            }
-        } // omp firstprivate
+        chess::Move bestMove;
+        stats::interiorNode();
+        stats::SplitTimer<> split(true);
+        if (isMaximizingPlayer) {
+            AtomicBestMove sharedBest(eval_constants::MIN_SCORE - 1);
+            #pragma omp parallel for reduction(+:nodesExplored)
+            for (const auto& child : gameNode.children()) {
+                auto busy = split.busy();
+                auto childAlpha = sharedAlpha.load(std::memory_order_relaxed);
+                if (beta <= childAlpha) {
+                    continue;
+                }
+                auto result = alphaBetaBlended(child, depth - 1, numSyncInterations, globalBounds, childAlpha, beta, false, resolveCaptures, table, context);
+                nodesExplored += result.nodesExplored;
+                auto score = result.bestMove.score();
+                reportRootMove(context, isRoot, child.lastMove(), score, depth, result.nodesExplored, isMaximizingPlayer);
+                sharedBest.updateMax(child.lastMove(), score);
+                fetchMax(sharedAlpha, score);
+            } // omp parallel for
+            bestMove = sharedBest.load();
+        } else {
+            AtomicBestMove sharedBest(eval_constants::MAX_SCORE + 1);
+            #pragma omp parallel for reduction(+:nodesExplored)
+            for (const auto& child : gameNode.children()) {
+                auto busy = split.busy();
+                auto childBeta = sharedBeta.load(std::memory_order_relaxed);
+                if (childBeta <= alpha) {
+                    continue;
+                }
+                auto result = alphaBetaBlended(child, depth - 1, numSyncInterations, globalBounds, alpha, childBeta, true, resolveCaptures, table, context);
+                nodesExplored += result.nodesExplored;
+                auto score = result.bestMove.score();
+                reportRootMove(context, isRoot, child.lastMove(), score, depth, result.nodesExplored, isMaximizingPlayer);
+                sharedBest.updateMin(child.lastMove(), score);
+                fetchMin(sharedBeta, score);
+            } // omp parallel for
+            bestMove = sharedBest.load();
+        }
+        if (failsHigh(bestMove.score(), alphaOrig, betaOrig, isMaximizingPlayer)) {
+            stats::cutoff(false);
+        }
+        storeTable(table, context, gameNode.board(), depth, alphaOrig, betaOrig, isMaximizingPlayer, bestMove);
         return {bestMove, nodesExplored};
     }
 } // end anonymous namespace
@@ -306,9 +1168,122 @@ AlphaBetaResult alphaBeta(
     std::uint8_t numSyncInterations,
     std::int16_t alpha,
     std::int16_t beta,
-    bool isMaximizingPlayer
+    bool isMaximizingPlayer,
+    TranspositionTable* table,
+    SearchContext* context
+) {
+    RootScope root(context, &gameNode);
+    GlobalBounds globalBounds{{alpha}, {beta}};
+    auto result = alphaBetaBlended(gameNode, depth, numSyncInterations, globalBounds, alpha, beta, isMaximizingPlayer, policy.resolveCaptures, table, context);
+    root.complete(result.bestMove, depth, result.nodesExplored);
+    return result;
+}
+
+AlphaBetaResult alphaBeta(
+    const MakeUnmakeTag& policy,
+    const GameNode& gameNode,
+    std::uint8_t depth,
+    std::int16_t alpha,
+    std::int16_t beta,
+    bool isMaximizingPlayer,
+    TranspositionTable* table,
+    SearchContext* context
+) {
+    // The worker searches in negamax form relative to the side to move, so the window and score
+    // are mirrored when the side to move at the root is the minimizing player
+    RootScope root(context, &gameNode);
+    SearchWorker worker(gameNode.board(), table);
+    worker.setContext(context);
+    auto result = isMaximizingPlayer ? worker.searchRoot(depth, alpha, beta) : worker.searchRoot(depth, -beta, -alpha);
+    if (!isMaximizingPlayer) {
+        result.bestMove.setScore(-result.bestMove.score());
+    }
+    root.complete(result.bestMove, depth, result.nodesExplored);
+    return result;
+}
+
+AlphaBetaResult alphaBeta(
+    const LazySMPTag& policy,
+    const GameNode& gameNode,
+    std::uint8_t depth,
+    std::int16_t alpha,
+    std::int16_t beta,
+    bool isMaximizingPlayer,
+    TranspositionTable* table,
+    SearchContext* context
 ) {
-    auto globalAlpha = std::make_shared<std::int16_t>(alpha);
-    auto globalBeta = std::make_shared<std::int16_t>(beta);
-    return alphaBetaBlended(gameNode, depth, numSyncInterations, globalAlpha, globalBeta, alpha, beta, isMaximizingPlayer);
+    // Threads share nothing but the table, so searching without one would only duplicate work
+    std::unique_ptr<TranspositionTable> localTable;
+    if (table == nullptr) {
+        localTable = std::make_unique<TranspositionTable>();
+        table = localTable.get();
+    }
+    table->bindScale(ScoreScale::CENTIPAWNS);
+    table->newSearch();
+
+    // Workers search in negamax form relative to the side to move at the root
+    const std::int16_t rootAlpha = isMaximizingPlayer ? alpha : -beta;
+    const std::int16_t rootBeta = isMaximizingPlayer ? beta : -alpha;
+
+    // The deepest completed iteration of any thread is the result, and is reported when it is found
+    RootScope root(context, &gameNode);
+    AtomicBestMove deepest(chess::Move(chess::Move::NO_MOVE));
+    std::atomic<size_t> totalNodes(0);
+
+    // Threads of a replicated table only share results with the threads of their node, so each node
+    // rotates the root moves over its own threads and keeps the subtrees it explores in its copy
+    const bool isNodeLocal = table->numCopies() > 1;
+    std::vector<int> threadNodes(omp_get_max_threads(), -1);
+
+    std::atomic<bool> stop(false);
+    size_t nodesExplored = 0;
+    stats::SplitTimer<> team(true);
+    #pragma omp parallel reduction(+:nodesExplored)
+    {
+        auto busy = team.busy();
+        const int threadIdx = omp_get_thread_num();
+        int helperIndex = threadIdx;
+        if (isNodeLocal) {
+            const int node = numa::currentNode();
+            threadNodes[threadIdx] = node;
+            #pragma omp barrier
+            helperIndex = std::count(threadNodes.begin(), threadNodes.begin() + threadIdx, node);
+        }
+
+        // Workers are constructed by their own thread so that their state is placed on its node
+        SearchWorker worker(gameNode.board(), table);
+        worker.setStopFlag(&stop);
+        worker.setContext(context);
+        worker.setHelperIndex(helperIndex);
+        size_t countedNodes = 0;
+
+        // Odd threads skip the first iteration so that threads are spread over adjacent depths
+        std::int16_t guess = 0;
+        for (int d = std::min<int>(depth, 1 + helperIndex % 2); d <= depth; ++d) {
+            auto iterationResult = worker.searchAspiration(d, guess, rootAlpha, rootBeta);
+            if (worker.stopped()) {
+                break;
+            }
+            guess = iterationResult.bestMove.score();
+            totalNodes.fetch_add(worker.nodesExplored() - countedNodes, std::memory_order_relaxed);
+            countedNodes = worker.nodesExplored();
+            if (deepest.updateDeeper(iterationResult.bestMove, d)) {
+                auto move = iterationResult.bestMove;
+                move.setScore(isMaximizingPlayer ? move.score() : -move.score());
+                root.complete(move, d, totalNodes.load(std::memory_order_relaxed));
+            }
+            // The first thread to complete the full depth stops the others
+            if (d == depth) {
+                stop.store(true);
+            }
+        }
+        nodesExplored += worker.nodesExplored();
+    } // omp parallel
+
+    // A stopped search returns the deepest iteration completed before the stop
+    AlphaBetaResult result{deepest.load(), nodesExplored};
+    if (!isMaximizingPlayer) {
+        result.bestMove.setScore(-result.bestMove.score());
+    }
+    return result;
 }
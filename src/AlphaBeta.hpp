@@ -5,7 +5,11 @@
 #ifndef ALPHA_BETA_HPP
 #define ALPHA_BETA_HPP
 
+#include "CompactTree.hpp"
+#include "Evaluation.hpp"
 #include "GameNode.hpp"
+#include "SearchContext.hpp"
+#include "TranspositionTable.hpp"
 #include <chess.hpp>
 
 #include <algorithm>
@@ -19,11 +23,71 @@ struct AlphaBetaResult
     size_t nodesExplored;
 };
 
-// Tag dispatching for algorithm execution policy
-struct SequentialTag {};
-struct SharedCutoffsTag {};
-struct LocalCutoffsTag {};
-struct BlendedCutoffsTag {};
+// Tag dispatching for algorithm execution policy. Game tree policies score the search horizon with the
+// static evaluation unless resolveCaptures is set, in which case quiescence search is run from it. The
+// make/unmake policies always run quiescence search.
+struct SequentialTag
+{
+    bool resolveCaptures = false;
+};
+struct SharedCutoffsTag
+{
+    bool resolveCaptures = false;
+};
+struct LocalCutoffsTag
+{
+    bool resolveCaptures = false;
+};
+struct BlendedCutoffsTag
+{
+    bool resolveCaptures = false;
+};
+struct MakeUnmakeTag {};
+struct LazySMPTag {};
+
+// Principal Variation Search: children after the first are scouted with a null window and only
+// searched again with the full window if they fail high
+struct PVSTag
+{
+    bool resolveCaptures = false;
+};
+
+// Sequential search over a compact game tree that reconstructs board positions on descent
+struct CompactTreeTag
+{
+    bool resolveCaptures = false;
+};
+
+// Young Brothers Wait Concept: siblings are only searched in parallel once the eldest has been
+// searched, and only at depths of at least minSplitDepth
+struct YBWCTag
+{
+    std::uint8_t minSplitDepth = 2;
+    bool resolveCaptures = false;
+};
+
+// Task-based Young Brothers Wait Concept: a single thread team executes sibling subtrees as OpenMP
+// tasks that idle threads pick up, and subtrees shallower than minSplitDepth are searched sequentially
+struct TaskTag
+{
+    std::uint8_t minSplitDepth = 3;
+    bool resolveCaptures = false;
+};
+
+/**
+ * @brief Quiescence search over captures and promotions from a position at the search horizon, so
+ * that leaves are only evaluated once the material balance is stable. The active player may always
+ * stand pat on the material balance, and captures that cannot raise it to within a margin of alpha
+ * are pruned. Checkmate and draws are scored as in GameNode::evaluateBoard.
+ *
+ * @param board Board position, which is restored before returning.
+ * @param alpha Best value that the active player can guarantee.
+ * @param beta Best value that the opponent can guarantee.
+ * @param nodesExplored Incremented by the number of positions evaluated.
+ *
+ * @return Score of the position relative to the active player in material units.
+ */
+std::int16_t quiescence(chess::Board& board, std::int16_t alpha, std::int16_t beta, size_t& nodesExplored);
 
 /**
  * @brief Sequential minimax algorithm with alpha-beta pruning.
@@ -34,6 +98,9 @@ struct BlendedCutoffsTag {};
  * @param alpha Best value that the maximizer can guarantee at this level or above.
  * @param beta Best value that the minimizer can guarantee at this level or above.
  * @param isMaximizingPlayer Indicates whether the active player is the maximizing player.
+ * @param table Transposition table shared by all threads, or nullptr to search without one.
+ * @param context Stop flag, limits and progress callback of the search, or nullptr to search to
+ * completion. A stopped search returns an incomplete result and stores nothing in the table.
  * 
  * @return Best move that the maximizing player can make with associated score.
  */
@@ -43,7 +110,47 @@ AlphaBetaResult alphaBeta(
     std::uint8_t depth,
     std::int16_t alpha = eval_constants::MIN_SCORE,
     std::int16_t beta = eval_constants::MAX_SCORE,
-    bool isMaximizingPlayer = true
+    bool isMaximizingPlayer = true,
+    TranspositionTable* table = nullptr,
+    SearchContext* context = nullptr
+);
+
+// Sequential implementation with null-window scouting of all but the first child
+AlphaBetaResult alphaBeta(
+    const PVSTag& policy,
+    const GameNode& gameNode,
+    std::uint8_t depth,
+    std::int16_t alpha = eval_constants::MIN_SCORE,
+    std::int16_t beta = eval_constants::MAX_SCORE,
+    bool isMaximizingPlayer = true,
+    TranspositionTable* table = nullptr,
+    SearchContext* context = nullptr
+);
+
+// Sequential implementation over a compact tree that is kept by the caller between searches, so that
+// nodes expanded by an earlier search are not generated again. Scores of searched nodes are recorded
+// in the tree.
+AlphaBetaResult alphaBeta(
+    const CompactTreeTag& policy,
+    CompactTree& tree,
+    std::uint8_t depth,
+    std::int16_t alpha = eval_constants::MIN_SCORE,
+    std::int16_t beta = eval_constants::MAX_SCORE,
+    bool isMaximizingPlayer = true,
+    TranspositionTable* table = nullptr,
+    SearchContext* context = nullptr
+);
+
+// Sequential implementation over a temporary compact tree built from the position of a game node
+AlphaBetaResult alphaBeta(
+    const CompactTreeTag& policy,
+    const GameNode& gameNode,
+    std::uint8_t depth,
+    std::int16_t alpha = eval_constants::MIN_SCORE,
+    std::int16_t beta = eval_constants::MAX_SCORE,
+    bool isMaximizingPlayer = true,
+    TranspositionTable* table = nullptr,
+    SearchContext* context = nullptr
 );
 
 // Shared memory parallel implementation with shared cutoff values
@@ -53,7 +160,9 @@ AlphaBetaResult alphaBeta(
     std::uint8_t depth,
     std::int16_t alpha = eval_constants::MIN_SCORE,
     std::int16_t beta = eval_constants::MAX_SCORE,
-    bool isMaximizingPlayer = true
+    bool isMaximizingPlayer = true,
+    TranspositionTable* table = nullptr,
+    SearchContext* context = nullptr
 );
 
 // Shared memory parallel implementation with local cutoff values
@@ -63,7 +172,9 @@ AlphaBetaResult alphaBeta(
     std::uint8_t depth,
     std::int16_t alpha = eval_constants::MIN_SCORE,
     std::int16_t beta = eval_constants::MAX_SCORE,
-    bool isMaximizingPlayer = true
+    bool isMaximizingPlayer = true,
+    TranspositionTable* table = nullptr,
+    SearchContext* context = nullptr
 );
 
 // Shared memory implementation with perioduc cutoff synchronization
@@ -74,7 +185,60 @@ AlphaBetaResult alphaBeta(
     std::uint8_t numSyncInterations = 1,
     std::int16_t alpha = eval_constants::MIN_SCORE,
     std::int16_t beta = eval_constants::MAX_SCORE,
-    bool isMaximizingPlayer = true
+    bool isMaximizingPlayer = true,
+    TranspositionTable* table = nullptr,
+    SearchContext* context = nullptr
+);
+
+// Shared memory parallel implementation that searches the eldest child before splitting
+AlphaBetaResult alphaBeta(
+    const YBWCTag& policy,
+    const GameNode& gameNode,
+    std::uint8_t depth,
+    std::int16_t alpha = eval_constants::MIN_SCORE,
+    std::int16_t beta = eval_constants::MAX_SCORE,
+    bool isMaximizingPlayer = true,
+    TranspositionTable* table = nullptr,
+    SearchContext* context = nullptr
+);
+
+// Shared memory parallel implementation using one thread team and a task per sibling subtree
+AlphaBetaResult alphaBeta(
+    const TaskTag& policy,
+    const GameNode& gameNode,
+    std::uint8_t depth,
+    std::int16_t alpha = eval_constants::MIN_SCORE,
+    std::int16_t beta = eval_constants::MAX_SCORE,
+    bool isMaximizingPlayer = true,
+    TranspositionTable* table = nullptr,
+    SearchContext* context = nullptr
+);
+
+// Sequential implementation on a single board with make/unmake instead of a game tree. Scores are in
+// centipawns from the incremental piece-square-table evaluation rather than in material units.
+AlphaBetaResult alphaBeta(
+    const MakeUnmakeTag& policy,
+    const GameNode& gameNode,
+    std::uint8_t depth,
+    std::int16_t alpha = -score_constants::INFINITE_SCORE,
+    std::int16_t beta = score_constants::INFINITE_SCORE,
+    bool isMaximizingPlayer = true,
+    TranspositionTable* table = nullptr,
+    SearchContext* context = nullptr
+);
+
+// Shared memory parallel implementation where every thread runs its own iterative deepening search
+// on a private board and threads only communicate through the transposition table. A table with the
+// default size is used if none is given. Scores are on the same centipawn scale as MakeUnmakeTag.
+AlphaBetaResult alphaBeta(
+    const LazySMPTag& policy,
+    const GameNode& gameNode,
+    std::uint8_t depth,
+    std::int16_t alpha = -score_constants::INFINITE_SCORE,
+    std::int16_t beta = score_constants::INFINITE_SCORE,
+    bool isMaximizingPlayer = true,
+    TranspositionTable* table = nullptr,
+    SearchContext* context = nullptr
 );
 
 #endif // ALPHA_BETA_HPP
@@ -0,0 +1,176 @@
+/**
+ * @file Analysis.cpp
+ */
+
+#include "Analysis.hpp"
+#include "GameNode.hpp"
+#include "TranspositionTable.hpp"
+#include <omp.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <sstream>
+#include <type_traits>
+
+namespace { // anonymous namespace
+    bool isNumber(const std::string& token) {
+        return !token.empty() && std::all_of(token.begin(), token.end(), [](unsigned char c) { return std::isdigit(c); });
+    }
+
+    /**
+     * @brief Search one position from the root and time the search.
+     */
+    template<typename Tag>
+    AnalysisRecord analyzePosition(
+        const Tag& policy,
+        size_t index,
+        const AnalysisPosition& position,
+        std::uint8_t depth,
+        TranspositionTable* table
+    ) {
+        GameNode root(position.fen);
+        auto start = std::chrono::steady_clock::now();
+        auto result = alphaBeta(policy, root, depth, -score_constants::INFINITE_SCORE, score_constants::INFINITE_SCORE, true, table);
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        return {
+            index,
+            position,
+            result.bestMove,
+            result.bestMove.score(),
+            result.nodesExplored,
+            elapsed.count(),
+            std::is_same_v<Tag, LazySMPTag>
+        };
+    }
+
+    std::string formatMove(const chess::Move& move) {
+        return move.move() == chess::Move::NO_MOVE ? "" : chess::uci::moveToUci(move);
+    }
+
+    // Quote a CSV field, doubling embedded quotes
+    std::string csvQuote(const std::string& field) {
+        std::string quoted = "\"";
+        for (char c : field) {
+            quoted += (c == '"') ? "\"\"" : std::string(1, c);
+        }
+        return quoted + "\"";
+    }
+
+    // Quote a JSON string, escaping quotes, backslashes and control characters
+    std::string jsonQuote(const std::string& field) {
+        std::string quoted = "\"";
+        for (char c : field) {
+            if (c == '"' || c == '\\') {
+                quoted += '\\';
+                quoted += c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                quoted += ' ';
+            } else {
+                quoted += c;
+            }
+        }
+        return quoted + "\"";
+    }
+} // end anonymous namespace
+
+std::vector<AnalysisPosition>
+readPositions(std::istream& in)
+{
+    std::vector<AnalysisPosition> positions;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream tokens(line);
+        std::vector<std::string> fields;
+        std::string token;
+        while (fields.size() < 6 && tokens >> token) {
+            fields.push_back(token);
+        }
+        if (fields.size() < 4 || fields[0][0] == '#') {
+            continue;
+        }
+
+        AnalysisPosition position;
+        position.fen = fields[0] + " " + fields[1] + " " + fields[2] + " " + fields[3];
+        if (fields.size() == 6 && isNumber(fields[4]) && isNumber(fields[5])) {
+            position.fen += " " + fields[4] + " " + fields[5];
+        } else {
+            // EPD record: operations follow the four position fields
+            position.fen += " 0 1";
+            auto idPos = line.find("id \"");
+            if (idPos != std::string::npos) {
+                auto idEnd = line.find('"', idPos + 4);
+                position.id = line.substr(idPos + 4, idEnd == std::string::npos ? std::string::npos : idEnd - idPos - 4);
+            }
+        }
+        positions.push_back(position);
+    }
+    return positions;
+}
+
+std::vector<AnalysisRecord>
+analyzePositions(const std::vector<AnalysisPosition>& positions, const AnalysisOptions& options)
+{
+    std::vector<AnalysisRecord> records(positions.size());
+    const size_t numThreads = omp_get_max_threads();
+    size_t tailStart = positions.size();
+    if (options.parallelTail && numThreads > 1) {
+        tailStart = positions.size() > numThreads ? positions.size() - numThreads : 0;
+    }
+
+    // Whole positions per thread: searches share nothing, so the team scales with the number of cores
+    if (tailStart > 0) {
+        #pragma omp parallel
+        {
+            TranspositionTable table(options.tableSizeMB);
+            #pragma omp for schedule(dynamic)
+            for (size_t i = 0; i < tailStart; ++i) {
+                records[i] = analyzePosition(MakeUnmakeTag{}, i, positions[i], options.depth, &table);
+            }
+        } // omp parallel
+    }
+
+    // The remaining positions would leave all but a few threads idle, so the team searches each together
+    if (tailStart < positions.size()) {
+        TranspositionTable table(options.tableSizeMB * numThreads);
+        for (size_t i = tailStart; i < positions.size(); ++i) {
+            records[i] = analyzePosition(LazySMPTag{}, i, positions[i], options.depth, &table);
+        }
+    }
+    return records;
+}
+
+void
+writeRecords(std::ostream& out, const std::vector<AnalysisRecord>& records, OutputFormat format)
+{
+    if (format == OutputFormat::CSV) {
+        out << "index,id,fen,best_move,score,nodes,time_ms,parallel" << std::endl;
+        for (const auto& record : records) {
+            out << record.index
+                << "," << csvQuote(record.position.id)
+                << "," << csvQuote(record.position.fen)
+                << "," << formatMove(record.bestMove)
+                << "," << record.score
+                << "," << record.nodesExplored
+                << "," << record.milliseconds
+                << "," << (record.parallel ? 1 : 0)
+                << std::endl;
+        }
+        return;
+    }
+
+    out << "[" << std::endl;
+    for (size_t i = 0; i < records.size(); ++i) {
+        const auto& record = records[i];
+        out << "  {\"index\": " << record.index
+            << ", \"id\": " << jsonQuote(record.position.id)
+            << ", \"fen\": " << jsonQuote(record.position.fen)
+            << ", \"best_move\": " << (record.bestMove.move() == chess::Move::NO_MOVE ? "null" : jsonQuote(formatMove(record.bestMove)))
+            << ", \"score\": " << record.score
+            << ", \"nodes\": " << record.nodesExplored
+            << ", \"time_ms\": " << record.milliseconds
+            << ", \"parallel\": " << (record.parallel ? "true" : "false")
+            << "}" << (i + 1 < records.size() ? "," : "") << std::endl;
+    }
+    out << "]" << std::endl;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file Analysis.hpp
+ */
+
+#ifndef ANALYSIS_HPP
+#define ANALYSIS_HPP
+
+#include "AlphaBeta.hpp"
+#include <chess.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Output format of a batch analysis
+enum class OutputFormat { CSV, JSON };
+
+// Position to analyze, with the id operation of its EPD record if it had one
+struct AnalysisPosition
+{
+    std::string fen;
+    std::string id;
+};
+
+// Result of analyzing one position. The score is in centipawns relative to the side to move.
+struct AnalysisRecord
+{
+    size_t index;
+    AnalysisPosition position;
+    chess::Move bestMove;
+    std::int16_t score;
+    size_t nodesExplored;
+    double milliseconds;
+    bool parallel;
+};
+
+// Options of a batch analysis
+struct AnalysisOptions
+{
+    std::uint8_t depth = 5;
+
+    // Search the last positions, which would otherwise leave most threads idle, one at a time with
+    // every thread instead of one position per thread
+    bool parallelTail = true;
+
+    // Size of the transposition table of each thread in megabytes
+    size_t tableSizeMB = 4;
+};
+
+/**
+ * @brief Read positions, one per line, as FEN strings or EPD records. EPD records carry no move
+ * counters and may be followed by operations, of which only id is kept. Blank lines and lines starting
+ * with '#' are skipped.
+ */
+std::vector<AnalysisPosition> readPositions(std::istream& in);
+
+/**
+ * @brief Analyze a batch of positions with position-level parallelism. Each thread of the OpenMP team
+ * claims whole positions and searches them sequentially with MakeUnmakeTag and its own transposition
+ * table, which keeps every core busy without the synchronization of a parallel tree search. Once fewer
+ * positions than threads remain, they are searched one after another with LazySMPTag over the whole
+ * team, unless disabled in the options.
+ *
+ * @return One record per position, in input order.
+ */
+std::vector<AnalysisRecord> analyzePositions(const std::vector<AnalysisPosition>& positions, const AnalysisOptions& options);
+
+/**
+ * @brief Write analysis records with a header row or as an array of JSON objects.
+ */
+void writeRecords(std::ostream& out, const std::vector<AnalysisRecord>& records, OutputFormat format);
+
+#endif // ANALYSIS_HPP
@@ -0,0 +1,59 @@
+/**
+ * @file Analyze.cpp
+ * @brief Batch analyzer: reads FEN strings or EPD records from a file or standard input, searches every
+ * position and writes the results to standard output.
+ *
+ * Usage: analyze [--depth N] [--json] [--no-tail] [file]
+ */
+
+#include "Analysis.hpp"
+#include "Search.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[])
+{
+    AnalysisOptions options;
+    auto format = OutputFormat::CSV;
+    std::string path;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--depth" && i + 1 < argc) {
+            int depth = options.depth;
+            try {
+                depth = std::stoi(argv[++i]);
+            } catch (const std::invalid_argument & e) {
+                std::cerr << "std::invalid_argument::what() " << e.what() << std::endl;
+            } catch (const std::out_of_range & e) {
+                std::cerr << "std::out_of_range::what() " << e.what() << std::endl;
+            }
+            if (depth < 1 || depth > search_constants::MAX_DEPTH) {
+                std::cerr << "Depth must be between 1 and " << static_cast<int>(search_constants::MAX_DEPTH) << "." << std::endl;
+                return 1;
+            }
+            options.depth = static_cast<std::uint8_t>(depth);
+        } else if (arg == "--json") {
+            format = OutputFormat::JSON;
+        } else if (arg == "--no-tail") {
+            options.parallelTail = false;
+        } else {
+            path = arg;
+        }
+    }
+
+    std::vector<AnalysisPosition> positions;
+    if (path.empty()) {
+        positions = readPositions(std::cin);
+    } else {
+        std::ifstream file(path);
+        if (!file) {
+            std::cerr << "Cannot open " << path << std::endl;
+            return 1;
+        }
+        positions = readPositions(file);
+    }
+    writeRecords(std::cout, analyzePositions(positions, options), format);
+    return 0;
+}
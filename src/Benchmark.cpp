@@ -0,0 +1,243 @@
+/**
+ * @file Benchmark.cpp
+ * @brief Searches a fixed suite of positions with every policy and reports time, nodes, nodes per
+ * second, effective branching factor, and against the sequential baseline of the same scoring scale,
+ * speedup, search overhead and best-move agreement. Rows are printed per position and policy, followed
+ * by a total per policy. The total number of nodes searched by the sequential baselines does not depend
+ * on timing or thread count, so it is printed to standard error as a signature to gate regressions.
+ * When compiled with search statistics, the statistics of every policy over the suite are printed to
+ * standard error as well.
+ *
+ * Usage: benchmark [--depth N] [--json]
+ */
+
+#include "AlphaBeta.hpp"
+#include "SearchStats.hpp"
+#include <omp.h>
+
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace { // anonymous namespace
+    const std::vector<std::string> BENCHMARK_SUITE = {
+        // Perft suite: move generation edge cases
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        // Bratko-Kopec test positions
+        "1k1r4/pp1b1R2/3q2pp/4p3/2B5/4Q3/PPP2B2/2K5 b - - 0 1",
+        "3r1k2/4npp1/1ppr3p/p6P/P2PPPP1/1NR5/5K2/2R5 w - - 0 1",
+        "2q1rr1k/3bbnnp/p2p1pp1/2pPp3/PpP1P1P1/1P2BNNP/2BQ1PRK/7R b - - 0 1",
+        "rnbqkb1r/p3pppp/1p6/2ppP3/3N4/2P5/PPP1QPPP/R1B1KB1R w KQkq - 0 1",
+        "r1b2rk1/2q1b1pp/p2ppn2/1p6/3QP3/1BN1B3/PPP3PP/R4RK1 w - - 0 1",
+        "2r3k1/pppR1pp1/4p3/4P1P1/5P2/1P4K1/P1P5/8 w - - 0 1",
+        "1nk1r1r1/pp2n1pp/4p3/q2pPp1N/b1pP1P2/B1P2R2/2P1B1PP/R2Q2K1 w - - 0 1",
+        "4b3/p3kp2/6p1/3pP2p/2pP1P2/4K1P1/P3N2P/8 w - - 0 1",
+        "2kr1bnr/pbpq4/2n1pp2/3p3p/3P1P1B/2N2N1Q/PPP3PP/2KR1B1R w - - 0 1",
+        "3rr1k1/pp3pp1/1qn2np1/8/3p4/PP1R1P2/2P1NQPP/R1B3K1 b - - 0 1",
+        "2r1nrk1/p2q1ppp/bp1p4/n1pPp3/P1P1P3/2PBB1N1/4QPPP/R4RK1 w - - 0 1",
+        "r3r1k1/ppqb1ppp/8/4p1NQ/8/2P5/PP3PPP/R3R1K1 b - - 0 1",
+        "r2q1rk1/4bppp/p2p4/2pP4/3pP3/3Q4/PP1B1PPP/R3R1K1 w - - 0 1",
+        "rnb2r1k/pp2p2p/2pp2p1/q2P1p2/8/1Pb2NP1/PB2PPBP/R2Q1RK1 w - - 0 1",
+        "2r3k1/1p2q1pp/2b1pr2/p1pp4/6Q1/1P1PP1R1/P1PN2PP/5RK1 w - - 0 1",
+        "r1bqkb1r/4npp1/p1p4p/1p1pP1B1/8/1B6/PPPN1PPP/R2Q1RK1 w kq - 0 1",
+        "r2q1rk1/1ppnbppp/p2p1nb1/3Pp3/2P1P1P1/2N2N1P/PPB1QP2/R1B2RK1 b - - 0 1",
+        "r1bq1rk1/pp2ppbp/2np2p1/2n5/P3PP2/N1P2N2/1PB3PP/R1B1QRK1 b - - 0 1",
+        "3rr3/2pq2pk/p2p1pnp/8/2QBPP2/1P6/P5PP/4RRK1 b - - 0 1",
+        "r4k2/pb2bp1r/1p1qp2p/3pNp2/3P1P2/2N3P1/PPP1Q2P/2KRR3 w - - 0 1",
+        "3rn2k/ppb2rpp/2ppqp2/5N2/2P1P3/1P5Q/PB3PPP/3RR1K1 w - - 0 1",
+        "2r2rk1/1bqnbpp1/1p1ppn1p/pP6/N1P1P3/P2B1N1P/1B2QPP1/R2R2K1 b - - 0 1",
+        "r1bqk2r/pp2bppp/2p5/3pP3/P2Q1P2/2N1B3/1PP3PP/R4RK1 b kq - 0 1",
+        "r2qnrnk/p2b2b1/1p1p2pp/2pPpp2/1PP1P3/PRNBB3/3QNPPP/5RK1 w - - 0 1",
+        // Openings and middlegames
+        "r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3",
+        "rnbqkb1r/pp2pppp/3p1n2/8/3NP3/8/PPP2PPP/RNBQKB1R w KQkq - 1 5",
+        "r1bqkb1r/pppp1ppp/2n2n2/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - 4 4",
+        "rnbqkbnr/ppp1pppp/8/3p4/4P3/8/PPPP1PPP/RNBQKBNR w KQkq - 0 2",
+        "r1bqk2r/pppp1ppp/2n2n2/2b1p3/2B1P3/3P1N2/PPP2PPP/RNBQK2R w KQkq - 1 5",
+        "rnbq1rk1/ppp1bppp/4pn2/3p4/2PP4/5NP1/PP2PPBP/RNBQ1RK1 w - - 2 6",
+        "r2qkb1r/pp2nppp/3p4/2pNN1B1/2BnP3/3P4/PPP2PPP/R2bK2R w KQkq - 1 10",
+        // Endgames and mates
+        "r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1",
+        "6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1",
+        "8/k7/3p4/p2P1p2/P2P1P2/8/8/K7 w - - 0 1",
+        "8/8/1p1k4/p2p4/P2P4/1P1K4/8/8 w - - 0 1",
+        "2k5/8/1K6/8/8/8/8/7Q w - - 0 1",
+        "4k3/8/8/8/8/8/4P3/4K3 w - - 0 1",
+        "8/5pk1/6p1/8/8/6P1/5PK1/8 w - - 0 1",
+        "8/1P6/8/8/8/8/6k1/K7 w - - 0 1",
+        "3k4/8/3K4/3P4/8/8/8/8 w - - 0 1",
+        "8/8/8/8/4k3/8/8/2BBK3 w - - 0 1",
+        "8/pp3k2/2p5/3p4/3P4/2P5/PP3K2/8 w - - 0 1",
+        "1k6/6R1/1K6/8/8/8/8/8 w - - 0 1",
+        "5Q2/p1r5/6K1/R7/6k1/P7/8/8 w - - 0 1",
+    };
+
+    using SearchFunction = std::function<AlphaBetaResult(const GameNode&, std::uint8_t)>;
+
+    // Policy under benchmark with the sequential policy on the same scoring scale that it is compared to
+    struct BenchmarkPolicy
+    {
+        std::string name;
+        std::string baseline;
+        SearchFunction search;
+    };
+
+    template<typename Tag>
+    SearchFunction searchWith() {
+        return [](const GameNode& root, std::uint8_t depth) { return alphaBeta(Tag{}, root, depth); };
+    }
+
+    // Measurements of one policy, for one position or totalled over the suite
+    struct BenchmarkRow
+    {
+        std::string position;
+        std::string policy;
+        double milliseconds = 0.0;
+        size_t nodes = 0;
+        double branchingFactor = 0.0;
+        double speedup = 0.0;
+        double overhead = 0.0;
+        double agreement = 0.0;
+        chess::Move bestMove;
+    };
+
+    void writeRow(std::ostream& out, const BenchmarkRow& row, int numThreads, int depth, bool json, bool last) {
+        const double nodesPerSecond = row.nodes / std::max(row.milliseconds / 1000.0, 1e-9);
+        if (json) {
+            out << "    {\"position\": \"" << row.position << "\", \"policy\": \"" << row.policy
+                << "\", \"num_threads\": " << numThreads << ", \"depth\": " << depth
+                << ", \"time_ms\": " << row.milliseconds << ", \"nodes\": " << row.nodes
+                << ", \"nps\": " << static_cast<size_t>(nodesPerSecond) << ", \"ebf\": " << row.branchingFactor
+                << ", \"speedup\": " << row.speedup << ", \"overhead\": " << row.overhead
+                << ", \"agreement\": " << row.agreement << "}" << (last ? "" : ",") << std::endl;
+        } else {
+            out << row.position << "," << row.policy << "," << numThreads << "," << depth
+                << "," << row.milliseconds << "," << row.nodes << "," << static_cast<size_t>(nodesPerSecond)
+                << "," << row.branchingFactor << "," << row.speedup << "," << row.overhead
+                << "," << row.agreement << std::endl;
+        }
+    }
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    int depth = 3;
+    bool json = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--depth" && i + 1 < argc) {
+            try {
+                depth = std::stoi(argv[++i]);
+            } catch (const std::invalid_argument & e) {
+                std::cerr << "std::invalid_argument::what() " << e.what() << std::endl;
+            } catch (const std::out_of_range & e) {
+                std::cerr << "std::out_of_range::what() " << e.what() << std::endl;
+            }
+        } else if (arg == "--json") {
+            json = true;
+        }
+    }
+
+    const std::vector<BenchmarkPolicy> policies = {
+        {"sequential", "sequential", searchWith<SequentialTag>()},
+        {"pvs", "sequential", searchWith<PVSTag>()},
+        {"compact_tree", "sequential", searchWith<CompactTreeTag>()},
+        {"shared", "sequential", searchWith<SharedCutoffsTag>()},
+        {"local", "sequential", searchWith<LocalCutoffsTag>()},
+        {"blended", "sequential", searchWith<BlendedCutoffsTag>()},
+        {"ybwc", "sequential", searchWith<YBWCTag>()},
+        {"tasks", "sequential", searchWith<TaskTag>()},
+        {"make_unmake", "make_unmake", searchWith<MakeUnmakeTag>()},
+        {"lazy_smp", "make_unmake", searchWith<LazySMPTag>()},
+    };
+
+    // Search every position with every policy; baselines come first in their families
+    std::vector<std::vector<BenchmarkRow>> rows(policies.size());
+    for (size_t p = 0; p < policies.size(); ++p) {
+        resetSearchStatistics();
+        for (size_t i = 0; i < BENCHMARK_SUITE.size(); ++i) {
+            auto root = std::make_unique<GameNode>(BENCHMARK_SUITE[i]);
+            auto start = std::chrono::steady_clock::now();
+            auto result = policies[p].search(*root, depth);
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+            BenchmarkRow row;
+            row.position = std::to_string(i);
+            row.policy = policies[p].name;
+            row.milliseconds = elapsed.count();
+            row.nodes = result.nodesExplored;
+            row.branchingFactor = std::pow(static_cast<double>(std::max<size_t>(row.nodes, 1)), 1.0 / depth);
+            row.bestMove = result.bestMove;
+            rows[p].push_back(row);
+        }
+        // Statistics over the suite, when compiled in, go to standard error to keep the rows parseable
+        if constexpr (stats_constants::ENABLED) {
+            std::cerr << "policy: " << policies[p].name << std::endl;
+            writeStatistics(std::cerr, searchStatistics());
+        }
+    }
+
+    // Compare with the baselines and total over the suite
+    size_t signature = 0;
+    std::vector<BenchmarkRow> totals;
+    for (size_t p = 0; p < policies.size(); ++p) {
+        size_t b = 0;
+        while (policies[b].name != policies[p].baseline) {
+            ++b;
+        }
+        BenchmarkRow total;
+        total.position = "total";
+        total.policy = policies[p].name;
+        double baselineMilliseconds = 0.0, logBranchingFactor = 0.0;
+        size_t baselineNodes = 0;
+        for (size_t i = 0; i < BENCHMARK_SUITE.size(); ++i) {
+            auto& row = rows[p][i];
+            const auto& baseline = rows[b][i];
+            row.speedup = baseline.milliseconds / std::max(row.milliseconds, 1e-9);
+            row.overhead = static_cast<double>(row.nodes) / std::max<size_t>(baseline.nodes, 1) - 1.0;
+            row.agreement = (row.bestMove == baseline.bestMove) ? 1.0 : 0.0;
+            total.milliseconds += row.milliseconds;
+            total.nodes += row.nodes;
+            total.agreement += row.agreement / BENCHMARK_SUITE.size();
+            logBranchingFactor += std::log(row.branchingFactor) / BENCHMARK_SUITE.size();
+            baselineMilliseconds += baseline.milliseconds;
+            baselineNodes += baseline.nodes;
+        }
+        total.branchingFactor = std::exp(logBranchingFactor);
+        total.speedup = baselineMilliseconds / std::max(total.milliseconds, 1e-9);
+        total.overhead = static_cast<double>(total.nodes) / std::max<size_t>(baselineNodes, 1) - 1.0;
+        totals.push_back(total);
+        if (b == p) {
+            signature += total.nodes;
+        }
+    }
+
+    const int numThreads = omp_get_max_threads();
+    if (json) {
+        std::cout << "{" << std::endl << "  \"signature\": " << signature << "," << std::endl << "  \"rows\": [" << std::endl;
+    } else {
+        std::cout << "position,policy,num_threads,depth,time_ms,nodes,nps,ebf,speedup,overhead,agreement" << std::endl;
+    }
+    for (size_t p = 0; p < policies.size(); ++p) {
+        for (const auto& row : rows[p]) {
+            writeRow(std::cout, row, numThreads, depth, json, false);
+        }
+    }
+    for (size_t p = 0; p < totals.size(); ++p) {
+        writeRow(std::cout, totals[p], numThreads, depth, json, p + 1 == totals.size());
+    }
+    if (json) {
+        std::cout << "  ]" << std::endl << "}" << std::endl;
+    }
+    std::cerr << "Benchmark signature: " << signature << std::endl;
+    return 0;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file CompactTree.cpp
+ */
+
+#include "CompactTree.hpp"
+#include "MoveOrdering.hpp"
+
+CompactTree::CompactTree(std::string_view fen)
+    : CompactTree(chess::Board(fen))
+{
+}
+
+CompactTree::CompactTree(const chess::Board& board)
+    : rootBoard_(board)
+{
+    clear();
+}
+
+void
+CompactTree::clear()
+{
+    moves_.clear();
+    scores_.clear();
+    firstChild_.clear();
+    numChildren_.clear();
+    addNode(chess::Move::NO_MOVE);
+}
+
+void
+CompactTree::addNode(std::uint16_t move)
+{
+    moves_.push_back(move);
+    scores_.push_back(0);
+    firstChild_.push_back(0);
+    numChildren_.push_back(UNEXPANDED);
+}
+
+void
+CompactTree::expand(NodeIndex node, const chess::Board& board)
+{
+    if (isExpanded(node)) {
+        return;
+    }
+
+    // Generate all legal moves, captures first, and append their nodes as one contiguous range
+    chess::Movelist movelist;
+    chess::movegen::legalmoves(movelist, board);
+    orderMoves(movelist, board);
+    firstChild_[node] = static_cast<NodeIndex>(size());
+    numChildren_[node] = static_cast<std::uint16_t>(movelist.size());
+    for (const auto& move : movelist) {
+        addNode(move.move());
+    }
+}
+
+bool
+CompactTree::promote(const chess::Move& move)
+{
+    NodeIndex promoted = 0;
+    if (isExpanded(root())) {
+        for (NodeIndex child = firstChild(root()); child < firstChild(root()) + numChildren(root()); ++child) {
+            if (moves_[child] == move.move()) {
+                promoted = child;
+                break;
+            }
+        }
+    }
+    rootBoard_.makeMove(move);
+    if (promoted == 0) {
+        clear();
+        return false;
+    }
+
+    // Copy the subtree breadth first into new arrays so that children stay contiguous. Each node is
+    // copied before its children, whose range is assigned once they are appended.
+    CompactTree subtree(rootBoard_);
+    subtree.scores_[root()] = scores_[promoted];
+    std::vector<NodeIndex> sources = {promoted};
+    for (NodeIndex node = 0; node < sources.size(); ++node) {
+        const auto source = sources[node];
+        if (!isExpanded(source)) {
+            continue;
+        }
+        subtree.firstChild_[node] = static_cast<NodeIndex>(subtree.size());
+        subtree.numChildren_[node] = numChildren_[source];
+        for (NodeIndex child = firstChild_[source]; child < firstChild_[source] + numChildren_[source]; ++child) {
+            subtree.addNode(moves_[child]);
+            subtree.scores_.back() = scores_[child];
+            sources.push_back(child);
+        }
+    }
+    moves_ = std::move(subtree.moves_);
+    scores_ = std::move(subtree.scores_);
+    firstChild_ = std::move(subtree.firstChild_);
+    numChildren_ = std::move(subtree.numChildren_);
+    return true;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file CompactTree.hpp
+ */
+
+#ifndef COMPACT_TREE_HPP
+#define COMPACT_TREE_HPP
+
+#include <chess.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class CompactTree
+ * @brief Game tree stored as a flat structure of arrays indexed by node. Each node only records the
+ * move leading to it, the score it was last searched with, and the index range of its children, which
+ * are stored contiguously. Only the root board position is kept: searches reconstruct the position of
+ * a node by making the moves on the path to it, so the tree takes a few bytes per node instead of a
+ * full board and can be kept between searches.
+ */
+class CompactTree
+{
+    public:
+        using NodeIndex = std::uint32_t;
+
+        // Bytes stored for each node across all arrays
+        static constexpr size_t BYTES_PER_NODE =
+            sizeof(std::uint16_t) + sizeof(std::int16_t) + sizeof(NodeIndex) + sizeof(std::uint16_t);
+
+        /**
+         * @brief Constructor.
+         *
+         * @param fen FEN string representation of the board position at the root.
+         */
+        explicit CompactTree(std::string_view fen = chess::constants::STARTPOS);
+
+        /**
+         * @brief Constructor.
+         *
+         * @param board Board position at the root.
+         */
+        explicit CompactTree(const chess::Board& board);
+
+        /**
+         * @brief Index of the root node.
+         */
+        static constexpr NodeIndex root() { return 0; }
+
+        /**
+         * @brief Accessor for the board position at the root.
+         */
+        const chess::Board& rootBoard() const { return rootBoard_; }
+
+        /**
+         * @brief Construct the children of a node from the legal moves of its position, captures
+         * first by their static MVV-LVA score, unless they have already been constructed.
+         *
+         * @param node Node to expand.
+         * @param board Board position of the node.
+         */
+        void expand(NodeIndex node, const chess::Board& board);
+
+        /**
+         * @brief Whether the children of a node have been constructed.
+         */
+        bool isExpanded(NodeIndex node) const { return numChildren_[node] != UNEXPANDED; }
+
+        /**
+         * @brief Index of the first child of an expanded node. Children are stored contiguously.
+         */
+        NodeIndex firstChild(NodeIndex node) const { return firstChild_[node]; }
+
+        /**
+         * @brief Number of children of an expanded node.
+         */
+        std::uint16_t numChildren(NodeIndex node) const { return numChildren_[node]; }
+
+        /**
+         * @brief Move leading from the parent of a node to the node.
+         */
+        chess::Move move(NodeIndex node) const { return chess::Move(moves_[node]); }
+
+        /**
+         * @brief Score of a node from its last search, relative to the maximizing player.
+         */
+        std::int16_t score(NodeIndex node) const { return scores_[node]; }
+
+        /**
+         * @brief Record the score of a node.
+         */
+        void setScore(NodeIndex node, std::int16_t score) { scores_[node] = score; }
+
+        /**
+         * @brief Number of nodes in the tree.
+         */
+        size_t size() const { return moves_.size(); }
+
+        /**
+         * @brief Bytes used by the node arrays, excluding unused capacity.
+         */
+        size_t memoryUsage() const { return size() * BYTES_PER_NODE; }
+
+        /**
+         * @brief Remove all nodes but the root.
+         */
+        void clear();
+
+        /**
+         * @brief Advance the root by a move. If the child reached by the move has been constructed, its
+         * subtree becomes the new tree with its nodes and scores kept, and the rest of the tree is
+         * discarded. Otherwise only the new root remains.
+         *
+         * @return Whether an existing child was promoted.
+         */
+        bool promote(const chess::Move& move);
+
+    private:
+        // Child count of nodes whose children have not been constructed
+        static constexpr std::uint16_t UNEXPANDED = std::numeric_limits<std::uint16_t>::max();
+
+        /**
+         * @brief Append a node without children.
+         */
+        void addNode(std::uint16_t move);
+
+        chess::Board rootBoard_;
+        std::vector<std::uint16_t> moves_;
+        std::vector<std::int16_t> scores_;
+        std::vector<NodeIndex> firstChild_;
+        std::vector<std::uint16_t> numChildren_;
+}; // class CompactTree
+
+#endif // COMPACT_TREE_HPP
@@ -0,0 +1,15 @@
+/**
+ * @file Engine.cpp
+ * @brief Entry point of the UCI engine, which serves commands from standard input until quit.
+ */
+
+#include "Uci.hpp"
+
+#include <iostream>
+
+int main()
+{
+    UciEngine engine(std::cin, std::cout);
+    engine.run();
+    return 0;
+}
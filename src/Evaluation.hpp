@@ -0,0 +1,94 @@
+/**
+ * @file Evaluation.hpp
+ */
+
+#ifndef EVALUATION_HPP
+#define EVALUATION_HPP
+
+#include <chess.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace score_constants {
+    // Bounds of the centipawn scale used by the make/unmake search
+    constexpr std::int16_t INFINITE_SCORE = 32000;
+
+    // Score of delivering checkmate at the root. Mates further away score lower by one per ply, so
+    // any score beyond MATE_BOUND is a forced mate.
+    constexpr std::int16_t MATE_SCORE = 31000;
+    constexpr std::int16_t MATE_BOUND = MATE_SCORE - 1000;
+
+    // Captures that cannot bring the evaluation within this margin of alpha are not searched
+    constexpr std::int16_t DELTA_MARGIN = 200;
+} // namespace score_constants
+
+/**
+ * @class Evaluator
+ * @brief Tapered material and piece-square-table evaluation maintained incrementally. Middle game and
+ * end game scores are kept for white relative to black together with the game phase, and are updated
+ * from the pieces that a move displaces rather than recounted at every leaf. The state before each
+ * move is kept on a stack so that unmaking a move restores it exactly.
+ */
+class Evaluator
+{
+    public:
+        /**
+         * @brief Constructor.
+         *
+         * @param board Position to evaluate initially.
+         */
+        explicit Evaluator(const chess::Board& board);
+
+        /**
+         * @brief Recompute the evaluation of a position from scratch and clear the move stack.
+         */
+        void reset(const chess::Board& board);
+
+        /**
+         * @brief Update the evaluation for a move. Must be called before the move is made on the board.
+         */
+        void makeMove(const chess::Board& board, const chess::Move& move);
+
+        /**
+         * @brief Restore the evaluation from before the last move made.
+         */
+        void unmakeMove() { state_ = stack_.back(); stack_.pop_back(); }
+
+        /**
+         * @brief Update the evaluation for passing the turn, which leaves the pieces unchanged.
+         */
+        void makeNullMove() { stack_.push_back(state_); }
+
+        /**
+         * @brief Restore the evaluation from before the last null move.
+         */
+        void unmakeNullMove() { unmakeMove(); }
+
+        /**
+         * @brief Score of the position in centipawns relative to the side to move, interpolated between
+         * the middle game and end game scores by the remaining material.
+         */
+        std::int16_t evaluate(const chess::Board& board) const;
+
+        /**
+         * @brief Middle game value of a piece type in centipawns, regardless of its square.
+         */
+        static std::int16_t pieceValue(chess::PieceType type);
+
+    private:
+        struct State
+        {
+            int middleGame;
+            int endGame;
+            int phase;
+        };
+
+        void addPiece(chess::Piece piece, chess::Square square);
+        void removePiece(chess::Piece piece, chess::Square square);
+
+        State state_;
+        std::vector<State> stack_;
+}; // class Evaluator
+
+#endif // EVALUATION_HPP
@@ -3,29 +3,71 @@
  */
 
 #include "GameNode.hpp"
+#include "MoveOrdering.hpp"
 
 GameNode::GameNode(chess::Board board, chess::Move move)
     : board_(board)
     , childrenInitialized_(false)
+    , children_(nullptr)
+    , numChildren_(0)
+    , arena_(nullptr)
 {
     // Execute move on the board position of the parent node
     makeMove(move);
 }
 
-const std::vector<std::unique_ptr<GameNode>>&
+GameNode::GameNode(const GameNode& other, NodeArena& arena)
+    : board_(other.board_)
+    , lastMove_(other.lastMove_)
+    , childrenInitialized_(other.childrenInitialized_)
+    , children_(nullptr)
+    , numChildren_(0)
+    , arena_(nullptr)
+{
+    if (other.numChildren_ > 0) {
+        arena_ = &arena;
+        children_ = static_cast<GameNode*>(arena_->allocate(other.numChildren_ * sizeof(GameNode), alignof(GameNode)));
+        for (std::uint16_t i = 0; i < other.numChildren_; ++i) {
+            new (children_ + numChildren_) GameNode(other.children_[i], arena);
+            ++numChildren_;
+        }
+    }
+}
+
+GameNode::Children
 GameNode::children() const
 {
     // Only construct child nodes if they have not already been initialized
     if (!childrenInitialized_) {
-        // Generate all legal moves and construct child nodes
+        // Generate all legal moves, captures first, and construct child nodes in a single array
         chess::Movelist movelist;
         chess::movegen::legalmoves(movelist, board_);
-        for (const auto& nextMove : movelist) {
-            children_.emplace_back(std::make_unique<GameNode>(board_, nextMove));
+        orderMoves(movelist, board_);
+        if (!movelist.empty()) {
+            arena_ = &NodeArena::local();
+            children_ = static_cast<GameNode*>(arena_->allocate(movelist.size() * sizeof(GameNode), alignof(GameNode)));
+            for (const auto& nextMove : movelist) {
+                new (children_ + numChildren_) GameNode(board_, nextMove);
+                ++numChildren_;
+            }
         }
         childrenInitialized_ = true;
     }
-    return children_;
+    return Children(children_, numChildren_);
+}
+
+void
+GameNode::clearChildren() const
+{
+    for (std::uint16_t i = 0; i < numChildren_; ++i) {
+        children_[i].~GameNode();
+    }
+    if (arena_ != nullptr) {
+        arena_->release();
+    }
+    children_ = nullptr;
+    numChildren_ = 0;
+    arena_ = nullptr;
 }
 
 void
@@ -37,31 +79,119 @@ GameNode::makeMove(const chess::Move& move)
 
     // Clear children and set flag back to false
     childrenInitialized_ = false;
-    children_.clear();
+    clearChildren();
+}
+
+bool
+GameNode::promote(const chess::Move& move)
+{
+    GameNode* child = nullptr;
+    for (std::uint16_t i = 0; i < numChildren_ && child == nullptr; ++i) {
+        if (children_[i].lastMove_ == move) {
+            child = &children_[i];
+        }
+    }
+    if (child == nullptr) {
+        makeMove(move);
+        return false;
+    }
+
+    // Copy the subtree into the spare generation so that the whole old tree is released
+    auto& spare = NodeArena::spare();
+    if (spare.liveAllocations() == 0) {
+        GameNode copy(*child, spare);
+        clearChildren();
+        board_ = std::move(copy.board_);
+        lastMove_ = move;
+        childrenInitialized_ = copy.childrenInitialized_;
+        children_ = copy.children_;
+        numChildren_ = copy.numChildren_;
+        arena_ = copy.arena_;
+        copy.children_ = nullptr;
+        copy.numChildren_ = 0;
+        copy.arena_ = nullptr;
+        NodeArena::nextGeneration();
+        return true;
+    }
+
+    // Take over the position and children of the child before the sibling array is destroyed
+    chess::Board board = std::move(child->board_);
+    auto childrenInitialized = child->childrenInitialized_;
+    auto children = child->children_;
+    auto numChildren = child->numChildren_;
+    auto arena = child->arena_;
+    child->children_ = nullptr;
+    child->numChildren_ = 0;
+    child->arena_ = nullptr;
+    clearChildren();
+
+    board_ = std::move(board);
+    lastMove_ = move;
+    childrenInitialized_ = childrenInitialized;
+    children_ = children;
+    numChildren_ = numChildren;
+    arena_ = arena;
+    return true;
 }
 
 std::int16_t
-GameNode::evaluateBoard() const
+GameNode::evaluateBoard(const chess::Board& board)
 {
     // Evaluate end game conditions relative to the active player
-    auto result = board_.isGameOver();
-    if (result.second == chess::GameResult::WIN)  return eval_constants::MAX_SCORE;
-    if (result.second == chess::GameResult::LOSE) return eval_constants::MIN_SCORE;
-    if (result.second == chess::GameResult::DRAW) return 0;
+    auto result = gameResult(board);
+    if (result == chess::GameResult::WIN)  return eval_constants::MAX_SCORE;
+    if (result == chess::GameResult::LOSE) return eval_constants::MIN_SCORE;
+    if (result == chess::GameResult::DRAW) return 0;
+    return evaluateMaterial(board);
+}
+
+chess::GameResult
+GameNode::gameResult(const chess::Board& board)
+{
+    // Same checks in the same order as Board::isGameOver
+    if (board.isHalfMoveDraw()) return board.getHalfMoveDrawType().second;
+    if (board.isInsufficientMaterial() || board.isRepetition()) return chess::GameResult::DRAW;
+    if (!hasLegalMove(board)) return board.inCheck() ? chess::GameResult::LOSE : chess::GameResult::DRAW;
+    return chess::GameResult::NONE;
+}
+
+bool
+GameNode::hasLegalMove(const chess::Board& board)
+{
+    // The king can move in most positions and is the only piece that can in double check. Pawns and
+    // knights are cheap to generate, and sliders are generated last.
+    using chess::PieceGenType;
+    constexpr int PIECE_GROUPS[] = {
+        PieceGenType::KING,
+        PieceGenType::PAWN | PieceGenType::KNIGHT,
+        PieceGenType::BISHOP | PieceGenType::ROOK | PieceGenType::QUEEN,
+    };
+    chess::Movelist movelist;
+    for (int pieces : PIECE_GROUPS) {
+        chess::movegen::legalmoves(movelist, board, pieces);
+        if (!movelist.empty()) {
+            return true;
+        }
+    }
+    return false;
+}
 
+std::int16_t
+GameNode::evaluateMaterial(const chess::Board& board)
+{
     // Number of pieces for each color
-    std::int16_t wKings = board_.pieces(chess::PieceType::KING, chess::Color::WHITE).count(),
-        bKings = board_.pieces(chess::PieceType::KING, chess::Color::BLACK).count(),
-        wQueens = board_.pieces(chess::PieceType::QUEEN, chess::Color::WHITE).count(),
-        bQueens = board_.pieces(chess::PieceType::QUEEN, chess::Color::BLACK).count(),
-        wRooks = board_.pieces(chess::PieceType::ROOK, chess::Color::WHITE).count(),
-        bRooks = board_.pieces(chess::PieceType::ROOK, chess::Color::BLACK).count(),
-        wBishops = board_.pieces(chess::PieceType::BISHOP, chess::Color::WHITE).count(),
-        bBishops = board_.pieces(chess::PieceType::BISHOP, chess::Color::BLACK).count(),
-        wKnights = board_.pieces(chess::PieceType::KNIGHT, chess::Color::WHITE).count(),
-        bKnights = board_.pieces(chess::PieceType::KNIGHT, chess::Color::BLACK).count(),
-        wPawns = board_.pieces(chess::PieceType::PAWN, chess::Color::WHITE).count(),
-        bPawns = board_.pieces(chess::PieceType::PAWN, chess::Color::BLACK).count();
+    std::int16_t wKings = board.pieces(chess::PieceType::KING, chess::Color::WHITE).count(),
+        bKings = board.pieces(chess::PieceType::KING, chess::Color::BLACK).count(),
+        wQueens = board.pieces(chess::PieceType::QUEEN, chess::Color::WHITE).count(),
+        bQueens = board.pieces(chess::PieceType::QUEEN, chess::Color::BLACK).count(),
+        wRooks = board.pieces(chess::PieceType::ROOK, chess::Color::WHITE).count(),
+        bRooks = board.pieces(chess::PieceType::ROOK, chess::Color::BLACK).count(),
+        wBishops = board.pieces(chess::PieceType::BISHOP, chess::Color::WHITE).count(),
+        bBishops = board.pieces(chess::PieceType::BISHOP, chess::Color::BLACK).count(),
+        wKnights = board.pieces(chess::PieceType::KNIGHT, chess::Color::WHITE).count(),
+        bKnights = board.pieces(chess::PieceType::KNIGHT, chess::Color::BLACK).count(),
+        wPawns = board.pieces(chess::PieceType::PAWN, chess::Color::WHITE).count(),
+        bPawns = board.pieces(chess::PieceType::PAWN, chess::Color::BLACK).count();
 
     // Compute material score for white
     std::int16_t materialScore =
@@ -74,9 +204,9 @@ GameNode::evaluateBoard() const
 
     // TODO do mobility score, possibly
     // chess::Movelist mvlist();
-    // mobilityScore = chess::movegen::legalmoves(mvlist, board_, );
+    // mobilityScore = chess::movegen::legalmoves(mvlist, board, );
 
     // Negate material score if black to move
-    std::int16_t whiteToMove = (board_.sideToMove() == chess::Color::WHITE) ? 1 : -1;
+    std::int16_t whiteToMove = (board.sideToMove() == chess::Color::WHITE) ? 1 : -1;
     return materialScore * whiteToMove;
 }
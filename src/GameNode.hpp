@@ -5,10 +5,10 @@
 #ifndef GAME_NODE_HPP
 #define GAME_NODE_HPP
 
+#include "NodeArena.hpp"
 #include <chess.hpp>
 
 #include <cstdint>
-#include <memory>
 #include <string_view>
 
 namespace eval_constants {
@@ -18,16 +18,39 @@ namespace eval_constants {
     // Define bounds for evaluation function
     constexpr std::int16_t MAX_SCORE = K_WT + Q_WT + 2*R_WT + 2*B_WT + 2*N_WT + 8*P_WT;
     constexpr std::int16_t MIN_SCORE = -MAX_SCORE;
+
+    // Captures that cannot bring the material balance within this margin of alpha are not searched
+    constexpr std::int16_t DELTA_MARGIN = 2;
 } // namespace EvalConstants
 
 /**
  * @class GameNode
- * @brief Represents a node in the game tree by storing the board position, last move, and a vector
- * of child nodes constructed from the set of legal moves to be considered from this node.
+ * @brief Represents a node in the game tree by storing the board position, last move, and an array
+ * of child nodes constructed from the set of legal moves to be considered from this node. Child nodes
+ * are stored contiguously in the arena of the thread that first expands the node.
  */
 class GameNode
 {
     public:
+        /**
+         * @brief Contiguous range of child nodes.
+         */
+        class Children
+        {
+            public:
+                Children(const GameNode* first, size_t size) : first_(first), size_(size) {}
+                const GameNode* begin() const { return first_; }
+                const GameNode* end() const { return first_ + size_; }
+                const GameNode& front() const { return *first_; }
+                const GameNode& operator[](size_t i) const { return first_[i]; }
+                size_t size() const { return size_; }
+                bool empty() const { return size_ == 0; }
+
+            private:
+                const GameNode* first_;
+                size_t size_;
+        }; // class Children
+
         // Delete copy constructor and assignment operator
         GameNode(const GameNode&) = delete;
         GameNode& operator=(const GameNode&) = delete;
@@ -38,7 +61,7 @@ class GameNode
          * @param fen FEN string representation of the desired starting board position.
          */
         GameNode(std::string_view fen = chess::constants::STARTPOS)
-            : board_(fen), lastMove_(), childrenInitialized_(false) {}
+            : board_(fen), lastMove_(), childrenInitialized_(false), children_(nullptr), numChildren_(0), arena_(nullptr) {}
 
         /**
          * @brief Constructor for all non-root nodes. 
@@ -49,9 +72,9 @@ class GameNode
         GameNode(chess::Board board, chess::Move move);
 
         /**
-         * @brief Default destructor.
+         * @brief Destructor. Destroys the child nodes in place and returns their array to its arena.
          */
-        ~GameNode() = default;
+        ~GameNode() { clearChildren(); }
 
         /**
          * @brief Accessor for the current board position.
@@ -64,26 +87,80 @@ class GameNode
         const chess::Move& lastMove() const { return lastMove_; }
 
         /**
-         * @brief Accessor for vector of child nodes with lazy initialization. Child nodes are only
-         * initialized the first time that this accessor is called.
+         * @brief Accessor for the child nodes with lazy initialization. Child nodes are only
+         * initialized the first time that this accessor is called, ordered by the static MVV-LVA
+         * score of their moves. The children of a node are shared by every thread that visits it,
+         * so the hash move, killer and history ordering of SearchWorker do not apply to them.
          */
-        const std::vector<std::unique_ptr<GameNode>>& children() const;
+        Children children() const;
         
         /**
          * @brief Execute given move on the current board position and store last move.
          */
         void makeMove(const chess::Move& move);
 
+        /**
+         * @brief Execute given move like makeMove, but if the child node reached by the move has already
+         * been constructed, make it the current node so that the subtree expanded below it by earlier
+         * searches is kept. All other children are destroyed.
+         *
+         * The kept subtree is copied into the spare arena generation of the calling thread, so that the
+         * old tree is released as a whole and the arenas it was allocated from rewind, rather than
+         * growing for as long as the game lasts. If the spare arena still holds another tree, the
+         * subtree is kept in place instead, and its arenas only rewind once the tree is destroyed.
+         *
+         * @return Whether an existing child was promoted.
+         */
+        bool promote(const chess::Move& move);
+
         /**
          * @brief Calculates a score for the current board position relative to the active player.
          */
-        std::int16_t evaluateBoard() const;
+        std::int16_t evaluateBoard() const { return evaluateBoard(board_); }
+
+        /**
+         * @brief Calculates a score for the given board position relative to the active player. Used
+         * by searches that operate on a board directly rather than on a tree of nodes.
+         */
+        static std::int16_t evaluateBoard(const chess::Board& board);
+
+        /**
+         * @brief Result of the game at the given board position relative to the active player, as
+         * Board::isGameOver reports it, but without generating every legal move to tell whether one
+         * exists.
+         */
+        static chess::GameResult gameResult(const chess::Board& board);
+
+        /**
+         * @brief Whether the active player has any legal move. Moves are generated one group of piece
+         * types at a time, king first, and generation stops at the first group with a legal move.
+         */
+        static bool hasLegalMove(const chess::Board& board);
+
+        /**
+         * @brief Material balance of the given board position relative to the active player, without
+         * checking whether the game is over.
+         */
+        static std::int16_t evaluateMaterial(const chess::Board& board);
 
     private:
+        /**
+         * @brief Constructor for a copy of a node and its subtree, whose child arrays are allocated
+         * from the given arena.
+         */
+        GameNode(const GameNode& other, NodeArena& arena);
+
+        /**
+         * @brief Destroy the child nodes and release their array.
+         */
+        void clearChildren() const;
+
         chess::Board board_;
         chess::Move lastMove_;
         mutable bool childrenInitialized_;
-        mutable std::vector<std::unique_ptr<GameNode>> children_;
+        mutable GameNode* children_;
+        mutable std::uint16_t numChildren_;
+        mutable NodeArena* arena_;
 }; // class GameNode
 
 #endif // GAME_NODE_HPP
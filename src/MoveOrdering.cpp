@@ -0,0 +1,116 @@
+/**
+ * @file MoveOrdering.cpp
+ */
+
+#include "MoveOrdering.hpp"
+
+#include <algorithm>
+
+namespace { // anonymous namespace
+    /**
+     * @brief Sort moves by descending score, keeping generation order among equal scores so that
+     * searches remain deterministic.
+     */
+    void sortByScore(chess::Movelist& movelist) {
+        std::stable_sort(movelist.begin(), movelist.end(), [](const chess::Move& a, const chess::Move& b) {
+            return a.score() > b.score();
+        });
+    }
+} // end anonymous namespace
+
+std::int16_t
+mvvLva(const chess::Board& board, const chess::Move& move)
+{
+    std::int16_t score = 0;
+    if (board.isCapture(move)) {
+        const int victim = (move.typeOf() == chess::Move::ENPASSANT)
+            ? static_cast<int>(chess::PieceType(chess::PieceType::PAWN))
+            : static_cast<int>(board.at<chess::PieceType>(move.to()));
+        const int attacker = board.at<chess::PieceType>(move.from());
+        score += 8 * (victim + 1) - attacker;
+    }
+    // Queen promotions gain as much material as capturing a queen
+    if (move.typeOf() == chess::Move::PROMOTION && move.promotionType() == chess::PieceType::QUEEN) {
+        score += 8 * (static_cast<int>(chess::PieceType(chess::PieceType::QUEEN)) + 1);
+    }
+    return score > 0 ? ordering_constants::GOOD_CAPTURE + score : 0;
+}
+
+void
+orderMoves(chess::Movelist& movelist, const chess::Board& board)
+{
+    for (auto& move : movelist) {
+        move.setScore(mvvLva(board, move));
+    }
+    sortByScore(movelist);
+}
+
+MoveOrdering::MoveOrdering(int maxPly)
+    : killers_(maxPly)
+{
+    clear();
+}
+
+void
+MoveOrdering::clear()
+{
+    for (auto& killers : killers_) {
+        killers.fill(chess::Move(chess::Move::NO_MOVE));
+    }
+    for (auto& side : history_) {
+        for (auto& from : side) {
+            from.fill(0);
+        }
+    }
+}
+
+void
+MoveOrdering::orderMoves(chess::Movelist& movelist, const chess::Board& board, int ply, const chess::Move& hashMove) const
+{
+    const auto& killers = killers_[ply];
+    const auto& history = history_[board.sideToMove()];
+    for (auto& move : movelist) {
+        std::int16_t score;
+        if (move == hashMove) {
+            score = ordering_constants::HASH_MOVE;
+        } else if ((score = mvvLva(board, move)) > 0) {
+            // Captures and queen promotions keep their MVV-LVA score
+        } else if (move == killers[0]) {
+            score = ordering_constants::FIRST_KILLER;
+        } else if (move == killers[1]) {
+            score = ordering_constants::SECOND_KILLER;
+        } else {
+            score = history[move.from().index()][move.to().index()];
+        }
+        move.setScore(score);
+    }
+    sortByScore(movelist);
+}
+
+void
+MoveOrdering::updateCutoff(const chess::Board& board, const chess::Move& move, int ply, int depth)
+{
+    // Captures are already ordered well by MVV-LVA
+    if (mvvLva(board, move) > 0) {
+        return;
+    }
+
+    auto& killers = killers_[ply];
+    if (killers[0] != move) {
+        killers[1] = killers[0];
+        killers[0] = move;
+    }
+
+    // Deeper cutoffs are more informative. Halve the table when an entry saturates so that old
+    // results fade and scores stay below the killer moves.
+    auto& history = history_[board.sideToMove()];
+    auto& entry = history[move.from().index()][move.to().index()];
+    entry = std::min<int>(entry + depth * depth, ordering_constants::MAX_HISTORY);
+    if (entry == ordering_constants::MAX_HISTORY) {
+        for (auto& from : history) {
+            for (auto& value : from) {
+                value /= 2;
+            }
+        }
+    }
+}
@@ -0,0 +1,87 @@
+/**
+ * @file MoveOrdering.hpp
+ */
+
+#ifndef MOVE_ORDERING_HPP
+#define MOVE_ORDERING_HPP
+
+#include <chess.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace ordering_constants {
+    // Ordering scores of each class of move, from most to least promising. Quiet moves are scored by
+    // their history, which is kept below the killer scores.
+    constexpr std::int16_t HASH_MOVE = 30000;
+    constexpr std::int16_t GOOD_CAPTURE = 20000;
+    constexpr std::int16_t FIRST_KILLER = 15000;
+    constexpr std::int16_t SECOND_KILLER = 14000;
+    constexpr std::int16_t MAX_HISTORY = 8000;
+} // namespace ordering_constants
+
+/**
+ * @brief Most Valuable Victim / Least Valuable Attacker score of a capture or promotion, or zero for a
+ * quiet move. Captures of more valuable pieces score higher, ties are broken by the cheaper attacker.
+ *
+ * @param board Board position before the move is made.
+ * @param move Move to score.
+ */
+std::int16_t mvvLva(const chess::Board& board, const chess::Move& move);
+
+/**
+ * @brief Order moves by their static MVV-LVA score, leaving quiet moves in generation order. Used where
+ * no per-thread search history is available, such as when expanding game tree nodes.
+ */
+void orderMoves(chess::Movelist& movelist, const chess::Board& board);
+
+/**
+ * @class MoveOrdering
+ * @brief Per-thread move ordering state for the make/unmake search: two killer moves per ply that
+ * recently caused a beta cutoff, and a history table of quiet moves indexed by side, origin and
+ * destination that accumulates how often each move caused a cutoff.
+ */
+class MoveOrdering
+{
+    public:
+        /**
+         * @brief Constructor.
+         *
+         * @param maxPly Number of plies for which killer moves are kept.
+         */
+        explicit MoveOrdering(int maxPly);
+
+        /**
+         * @brief Forget all killer moves and history.
+         */
+        void clear();
+
+        /**
+         * @brief Score and sort moves in place: hash move, then captures and promotions by MVV-LVA,
+         * then killer moves of this ply, then remaining quiet moves by history.
+         *
+         * @param movelist Legal moves of the current position.
+         * @param board Current position.
+         * @param ply Distance from the root, used to select killer moves.
+         * @param hashMove Best move stored in the transposition table, or a null move.
+         */
+        void orderMoves(chess::Movelist& movelist, const chess::Board& board, int ply, const chess::Move& hashMove) const;
+
+        /**
+         * @brief Record a quiet move that caused a beta cutoff as a killer of its ply and reward it in
+         * the history table.
+         *
+         * @param board Current position, before the move is made.
+         * @param move Move that caused the cutoff.
+         * @param ply Distance from the root.
+         * @param depth Remaining depth at which the cutoff happened.
+         */
+        void updateCutoff(const chess::Board& board, const chess::Move& move, int ply, int depth);
+
+    private:
+        std::vector<std::array<chess::Move, 2>> killers_;
+        std::array<std::array<std::array<std::int16_t, 64>, 64>, 2> history_;
+}; // class MoveOrdering
+
+#endif // MOVE_ORDERING_HPP
@@ -0,0 +1,98 @@
+/**
+ * @file NodeArena.cpp
+ */
+
+#include "NodeArena.hpp"
+
+#include <algorithm>
+
+namespace { // anonymous namespace
+    // Arenas of a thread, one per generation
+    struct LocalArenas
+    {
+        NodeArena arenas[2];
+        int current = 0;
+    };
+
+    LocalArenas& localArenas() {
+        thread_local LocalArenas instance;
+        return instance;
+    }
+} // end anonymous namespace
+
+NodeArena::NodeArena(size_t blockSize)
+    : blockSize_(blockSize)
+    , blockIndex_(0)
+    , offset_(0)
+    , live_(0)
+{
+}
+
+NodeArena::~NodeArena()
+{
+    if (live_.load(std::memory_order_acquire) != 0) {
+        for (auto& block : blocks_) {
+            block.data.release();
+        }
+    }
+}
+
+NodeArena&
+NodeArena::local()
+{
+    auto& local = localArenas();
+    return local.arenas[local.current];
+}
+
+NodeArena&
+NodeArena::spare()
+{
+    auto& local = localArenas();
+    return local.arenas[1 - local.current];
+}
+
+void
+NodeArena::nextGeneration()
+{
+    auto& local = localArenas();
+    local.current = 1 - local.current;
+}
+
+void*
+NodeArena::allocate(size_t bytes, size_t alignment)
+{
+    // Only this thread allocates, so once every allocation has been released no other thread can
+    // hold memory of the arena and all blocks can be reused
+    if (live_.load(std::memory_order_acquire) == 0) {
+        blockIndex_ = 0;
+        offset_ = 0;
+    }
+
+    while (true) {
+        if (blockIndex_ == blocks_.size()) {
+            // Requests larger than a block get a block of their own
+            size_t size = std::max(blockSize_, bytes + alignment);
+            blocks_.push_back({std::make_unique<std::byte[]>(size), size});
+            offset_ = 0;
+        }
+        auto& block = blocks_[blockIndex_];
+        size_t start = (offset_ + alignment - 1) & ~(alignment - 1);
+        if (start + bytes <= block.size) {
+            offset_ = start + bytes;
+            live_.fetch_add(1, std::memory_order_relaxed);
+            return block.data.get() + start;
+        }
+        ++blockIndex_;
+        offset_ = 0;
+    }
+}
+
+size_t
+NodeArena::bytesReserved() const
+{
+    size_t bytes = 0;
+    for (const auto& block : blocks_) {
+        bytes += block.size;
+    }
+    return bytes;
+}
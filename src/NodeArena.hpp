@@ -0,0 +1,99 @@
+/**
+ * @file NodeArena.hpp
+ */
+
+#ifndef NODE_ARENA_HPP
+#define NODE_ARENA_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @class NodeArena
+ * @brief Bump allocator for the child arrays of game tree nodes. Each thread allocates from its own
+ * arena, so expanding nodes never contends on the global heap, and memory is carved from large blocks
+ * that are kept for reuse. Allocations are not freed individually: the arena counts the allocations
+ * still alive, which may be released from any thread, and rewinds to its first block in constant time
+ * the next time its thread allocates after all of them have been released. Each thread has an arena
+ * for each of two generations, so that a tree kept across moves can be copied out of the arenas of the
+ * tree it came from, which then rewind.
+ */
+class NodeArena
+{
+    public:
+        // Delete copy constructor and assignment operator
+        NodeArena(const NodeArena&) = delete;
+        NodeArena& operator=(const NodeArena&) = delete;
+
+        // Size of each block of memory requested from the heap
+        static constexpr size_t DEFAULT_BLOCK_SIZE = 1 << 20;
+
+        /**
+         * @brief Constructor.
+         *
+         * @param blockSize Size of each block of memory requested from the heap.
+         */
+        explicit NodeArena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+        /**
+         * @brief Destructor. Blocks that still hold live allocations are leaked rather than freed so
+         * that trees outliving the thread of the arena remain valid.
+         */
+        ~NodeArena();
+
+        /**
+         * @brief Arena of the calling thread that new allocations are made from.
+         */
+        static NodeArena& local();
+
+        /**
+         * @brief Arena of the calling thread of the other generation, which is empty once every tree
+         * allocated from it before the last generation switch has been destroyed.
+         */
+        static NodeArena& spare();
+
+        /**
+         * @brief Make the spare arena of the calling thread the arena that new allocations are made from.
+         */
+        static void nextGeneration();
+
+        /**
+         * @brief Allocate uninitialized memory. Must only be called from the thread that owns the arena.
+         *
+         * @param bytes Number of bytes to allocate.
+         * @param alignment Required alignment, at most that of std::max_align_t.
+         */
+        void* allocate(size_t bytes, size_t alignment);
+
+        /**
+         * @brief Mark an allocation as no longer used. May be called from any thread.
+         */
+        void release() { live_.fetch_sub(1, std::memory_order_release); }
+
+        /**
+         * @brief Number of allocations that have not been released.
+         */
+        size_t liveAllocations() const { return live_.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Total size of the blocks held by the arena.
+         */
+        size_t bytesReserved() const;
+
+    private:
+        struct Block
+        {
+            std::unique_ptr<std::byte[]> data;
+            size_t size;
+        };
+
+        size_t blockSize_;
+        std::vector<Block> blocks_;
+        size_t blockIndex_;
+        size_t offset_;
+        std::atomic<size_t> live_;
+}; // class NodeArena
+
+#endif // NODE_ARENA_HPP
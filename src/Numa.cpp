@@ -0,0 +1,156 @@
+/**
+ * @file Numa.cpp
+ */
+
+#include "Numa.hpp"
+#include <sched.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace { // anonymous namespace
+    // Configuration together with the node of every processor that it implies
+    struct NumaState
+    {
+        numa::Config config;
+        std::vector<int> cpuNodes;
+        int numNodes = 1;
+
+        // Incremented by every reconfiguration so that threads look up their node again
+        unsigned generation = 0;
+    };
+
+    numa::Config readEnvironment() {
+        numa::Config config;
+        if (const char* tables = std::getenv("NUMA_TABLES")) {
+            const std::string mode(tables);
+            if (mode == "partitioned") {
+                config.tables = TablePlacement::PARTITIONED;
+            } else if (mode == "replicated") {
+                config.tables = TablePlacement::REPLICATED;
+            }
+        }
+        if (const char* nodes = std::getenv("NUMA_NODES")) {
+            config.emulatedNodes = std::max(0, std::atoi(nodes));
+        }
+        return config;
+    }
+
+    // Processors of each node of the machine that has any, or all processors on a single node
+    std::vector<std::vector<int>> readNodes() {
+        std::vector<std::vector<int>> nodes;
+        for (int node = 0; ; ++node) {
+            std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            if (!file) {
+                break;
+            }
+            std::string list;
+            std::getline(file, list);
+            auto cpus = numa::parseCpuList(list);
+            if (!cpus.empty()) {
+                nodes.push_back(std::move(cpus));
+            }
+        }
+        if (nodes.empty()) {
+            nodes.emplace_back();
+            for (int cpu = 0; cpu < static_cast<int>(std::max(1u, std::thread::hardware_concurrency())); ++cpu) {
+                nodes.back().push_back(cpu);
+            }
+        }
+        return nodes;
+    }
+
+    void applyConfig(NumaState& state, const numa::Config& config) {
+        auto nodes = readNodes();
+
+        // Emulated nodes split the processors in order into groups of nearly equal size, and are left
+        // without processors if there are more nodes than processors
+        if (config.emulatedNodes > 0) {
+            std::vector<int> cpus;
+            for (const auto& node : nodes) {
+                cpus.insert(cpus.end(), node.begin(), node.end());
+            }
+            std::sort(cpus.begin(), cpus.end());
+            const size_t numNodes = config.emulatedNodes;
+            nodes.assign(numNodes, {});
+            for (size_t i = 0; i < cpus.size(); ++i) {
+                nodes[i * numNodes / cpus.size()].push_back(cpus[i]);
+            }
+        }
+
+        state.config = config;
+        state.numNodes = static_cast<int>(nodes.size());
+        state.cpuNodes.clear();
+        for (int node = 0; node < state.numNodes; ++node) {
+            for (int cpu : nodes[node]) {
+                state.cpuNodes.resize(std::max<size_t>(state.cpuNodes.size(), cpu + 1), 0);
+                state.cpuNodes[cpu] = node;
+            }
+        }
+        ++state.generation;
+    }
+
+    NumaState& state() {
+        static NumaState instance = [] {
+            NumaState initial;
+            applyConfig(initial, readEnvironment());
+            return initial;
+        }();
+        return instance;
+    }
+} // end anonymous namespace
+
+const numa::Config&
+numa::config()
+{
+    return state().config;
+}
+
+void
+numa::configure(const Config& config)
+{
+    applyConfig(state(), config);
+}
+
+std::vector<int>
+numa::parseCpuList(const std::string& list)
+{
+    std::vector<int> cpus;
+    std::istringstream stream(list);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        if (range.find_first_of("0123456789") == std::string::npos) {
+            continue;
+        }
+        const auto dash = range.find('-');
+        const int first = std::atoi(range.substr(0, dash).c_str());
+        const int last = dash == std::string::npos ? first : std::atoi(range.substr(dash + 1).c_str());
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+int
+numa::numNodes()
+{
+    return state().numNodes;
+}
+
+int
+numa::currentNode()
+{
+    thread_local unsigned generation = 0;
+    thread_local int node = 0;
+    const auto& current = state();
+    if (generation != current.generation) {
+        const int cpu = sched_getcpu();
+        node = (cpu >= 0 && cpu < static_cast<int>(current.cpuNodes.size())) ? current.cpuNodes[cpu] : 0;
+        generation = current.generation;
+    }
+    return node;
+}
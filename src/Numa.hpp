@@ -0,0 +1,67 @@
+/**
+ * @file Numa.hpp
+ */
+
+#ifndef NUMA_HPP
+#define NUMA_HPP
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief Placement of the memory of a transposition table across NUMA nodes. A shared table is
+ * initialized by the thread that constructs it, so that all of its pages land on the node of that
+ * thread. A partitioned table is initialized by the whole thread team in contiguous ranges, so that
+ * its pages are spread over the nodes the threads run on. A replicated table holds one independent
+ * copy per node, initialized by the threads of that node, and each thread only probes and stores in
+ * the copy of its own node.
+ */
+enum class TablePlacement { SHARED, PARTITIONED, REPLICATED };
+
+namespace numa {
+    /**
+     * @brief NUMA mode of the searches. Threads are pinned by the OpenMP runtime, as with
+     * OMP_PLACES=cores and OMP_PROC_BIND=close, so that thread numbers map onto nodes in order and
+     * every thread stays on its node. The mode then decides where shared memory is placed relative to
+     * the threads.
+     */
+    struct Config
+    {
+        // Placement of transposition tables constructed without an explicit placement
+        TablePlacement tables = TablePlacement::SHARED;
+
+        // Number of nodes to split the processors into, or zero to use the nodes of the machine.
+        // Emulates a multi-node machine on a single node, where placement changes nothing but the
+        // code paths taken.
+        int emulatedNodes = 0;
+    };
+
+    /**
+     * @brief Current configuration, read from the environment on first use. NUMA_TABLES selects
+     * shared, partitioned or replicated tables and NUMA_NODES the number of emulated nodes.
+     */
+    const Config& config();
+
+    /**
+     * @brief Replace the configuration. Not thread-safe: must not be called while a search is running.
+     */
+    void configure(const Config& config);
+
+    /**
+     * @brief Parse a list of processors in the format of Linux sysfs, such as "0-3,8,10-11".
+     */
+    std::vector<int> parseCpuList(const std::string& list);
+
+    /**
+     * @brief Number of nodes, which is 1 if the topology cannot be read.
+     */
+    int numNodes();
+
+    /**
+     * @brief Node of the processor that the calling thread runs on. Threads are expected to be pinned,
+     * so the node is looked up once per thread and configuration.
+     */
+    int currentNode();
+} // namespace numa
+
+#endif // NUMA_HPP
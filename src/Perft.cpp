@@ -0,0 +1,154 @@
+/**
+ * @file Perft.cpp
+ */
+
+#include "Perft.hpp"
+
+#include <algorithm>
+
+namespace { // anonymous namespace
+    // Layout of a packed entry: depth (8 bits) and node count (56)
+    constexpr int NODES_SHIFT = 8;
+
+    std::uint64_t perftTree(const GameNode& gameNode, int depth) {
+        if (depth == 0) {
+            return 1;
+        }
+        // Leaves are constructed as a search would construct them, but not expanded further
+        if (depth == 1) {
+            return gameNode.children().size();
+        }
+        std::uint64_t nodes = 0;
+        for (const auto& child : gameNode.children()) {
+            nodes += perftTree(child, depth - 1);
+        }
+        return nodes;
+    }
+} // end anonymous namespace
+
+const std::vector<PerftPosition>&
+perftSuite()
+{
+    static const std::vector<PerftPosition> suite = {
+        {"startpos", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+            {20, 400, 8902, 197281, 4865609, 119060324}},
+        {"kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+            {48, 2039, 97862, 4085603, 193690690}},
+        {"position3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+            {14, 191, 2812, 43238, 674624, 11030083}},
+        {"position4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+            {6, 264, 9467, 422333, 15833292}},
+        {"position5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+            {44, 1486, 62379, 2103487, 89941194}},
+        {"position6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+            {46, 2079, 89890, 3894594, 164075551}},
+    };
+    return suite;
+}
+
+PerftTable::PerftTable(size_t sizeMB)
+    : numSlots_(std::max<size_t>(1, sizeMB * 1024 * 1024 / sizeof(Slot)))
+{
+    slots_ = std::make_unique<Slot[]>(numSlots_);
+}
+
+bool
+PerftTable::probe(std::uint64_t key, int depth, std::uint64_t& nodes) const
+{
+    const auto& slot = slotFor(key);
+    auto data = slot.data.load(std::memory_order_relaxed);
+    if ((slot.key.load(std::memory_order_relaxed) ^ data) != key || static_cast<int>(data & 0xFF) != depth) {
+        return false;
+    }
+    nodes = data >> NODES_SHIFT;
+    return true;
+}
+
+void
+PerftTable::store(std::uint64_t key, int depth, std::uint64_t nodes)
+{
+    auto& slot = slotFor(key);
+    auto data = (nodes << NODES_SHIFT) | static_cast<std::uint8_t>(depth);
+    slot.key.store(key ^ data, std::memory_order_relaxed);
+    slot.data.store(data, std::memory_order_relaxed);
+}
+
+std::uint64_t
+perft(const GameNode& root, int depth)
+{
+    if (depth == 0) {
+        return 1;
+    }
+    chess::Movelist movelist;
+    chess::movegen::legalmoves(movelist, root.board());
+    std::uint64_t nodes = 0;
+    for (const auto& move : movelist) {
+        // The tree of each root move is released before the next so that the arena can rewind
+        GameNode subtree(root.board(), move);
+        nodes += perftTree(subtree, depth - 1);
+    }
+    return nodes;
+}
+
+std::uint64_t
+perftParallel(const GameNode& root, int depth)
+{
+    if (depth == 0) {
+        return 1;
+    }
+    chess::Movelist movelist;
+    chess::movegen::legalmoves(movelist, root.board());
+    std::uint64_t nodes = 0;
+    #pragma omp parallel for schedule(dynamic) reduction(+:nodes)
+    for (int i = 0; i < movelist.size(); ++i) {
+        GameNode subtree(root.board(), movelist[i]);
+        nodes += perftTree(subtree, depth - 1);
+    } // omp parallel for
+    return nodes;
+}
+
+std::uint64_t
+perft(chess::Board& board, int depth, PerftTable* table)
+{
+    if (depth == 0) {
+        return 1;
+    }
+    // Counts of the last ply are cheaper to generate than to look up
+    std::uint64_t nodes = 0;
+    if (depth > 1 && table != nullptr && table->probe(board.hash(), depth, nodes)) {
+        return nodes;
+    }
+    chess::Movelist movelist;
+    chess::movegen::legalmoves(movelist, board);
+    if (depth == 1) {
+        return movelist.size();
+    }
+    for (const auto& move : movelist) {
+        board.makeMove(move);
+        nodes += perft(board, depth - 1, table);
+        board.unmakeMove(move);
+    }
+    if (table != nullptr) {
+        table->store(board.hash(), depth, nodes);
+    }
+    return nodes;
+}
+
+std::uint64_t
+perftParallel(const chess::Board& board, int depth, PerftTable* table)
+{
+    if (depth <= 1) {
+        chess::Board copy = board;
+        return perft(copy, depth, table);
+    }
+    chess::Movelist movelist;
+    chess::movegen::legalmoves(movelist, board);
+    std::uint64_t nodes = 0;
+    #pragma omp parallel for schedule(dynamic) reduction(+:nodes)
+    for (int i = 0; i < movelist.size(); ++i) {
+        chess::Board copy = board;
+        copy.makeMove(movelist[i]);
+        nodes += perft(copy, depth - 1, table);
+    } // omp parallel for
+    return nodes;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file Perft.hpp
+ */
+
+#ifndef PERFT_HPP
+#define PERFT_HPP
+
+#include "GameNode.hpp"
+#include <chess.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace perft_constants {
+    // Deepest perft over a game tree that stays within memory: the tree of the largest root move is
+    // materialized, at roughly 250 bytes per node
+    constexpr int MAX_TREE_DEPTH = 4;
+} // namespace perft_constants
+
+// Position of the perft suite with its known node counts, indexed by depth - 1
+struct PerftPosition
+{
+    std::string name;
+    std::string fen;
+    std::vector<std::uint64_t> nodes;
+};
+
+/**
+ * @brief Standard perft positions with published node counts: the starting position, Kiwipete and
+ * positions 3 to 6 of the Chess Programming Wiki, which together cover castling, en passant,
+ * promotions, checks and pins.
+ */
+const std::vector<PerftPosition>& perftSuite();
+
+/**
+ * @class PerftTable
+ * @brief Fixed-size table of subtree node counts keyed on the Zobrist hash of the board and the depth,
+ * shared by all threads without locks. As in TranspositionTable, each slot holds the packed entry and
+ * the key XORed with it, so a slot torn by concurrent writers reads as a miss.
+ */
+class PerftTable
+{
+    public:
+        // Delete copy constructor and assignment operator
+        PerftTable(const PerftTable&) = delete;
+        PerftTable& operator=(const PerftTable&) = delete;
+
+        /**
+         * @brief Constructor.
+         *
+         * @param sizeMB Size of the table in megabytes.
+         */
+        explicit PerftTable(size_t sizeMB = 16);
+
+        /**
+         * @brief Look up the node count of a position at a depth.
+         *
+         * @return Whether the count was found, in which case nodes holds it.
+         */
+        bool probe(std::uint64_t key, int depth, std::uint64_t& nodes) const;
+
+        /**
+         * @brief Store the node count of a position at a depth, replacing the slot of its key.
+         */
+        void store(std::uint64_t key, int depth, std::uint64_t nodes);
+
+    private:
+        struct Slot
+        {
+            std::atomic<std::uint64_t> key{0};
+            std::atomic<std::uint64_t> data{0};
+        };
+
+        Slot& slotFor(std::uint64_t key) const {
+            return slots_[static_cast<size_t>((static_cast<unsigned __int128>(key) * numSlots_) >> 64)];
+        }
+
+        std::unique_ptr<Slot[]> slots_;
+        size_t numSlots_;
+}; // class PerftTable
+
+/**
+ * @brief Count the leaves of the game tree of a given depth by expanding it with GameNode::children,
+ * which measures tree construction: move generation, board copies and node allocation. Each root move
+ * is expanded into its own tree that is destroyed before the next, so only one subtree is held at once.
+ */
+std::uint64_t perft(const GameNode& root, int depth);
+
+/**
+ * @brief Parallel variant of the game tree perft that distributes root moves over the OpenMP team.
+ */
+std::uint64_t perftParallel(const GameNode& root, int depth);
+
+/**
+ * @brief Count the leaves of the game tree of a given depth with make/unmake on a single board, which
+ * measures move generation alone. Moves at the last ply are counted without being made.
+ *
+ * @param board Board position, which is restored before returning.
+ * @param depth Depth of the tree.
+ * @param table Table of subtree counts to reuse transposed subtrees, or nullptr.
+ */
+std::uint64_t perft(chess::Board& board, int depth, PerftTable* table = nullptr);
+
+/**
+ * @brief Parallel variant of the make/unmake perft that distributes root moves over the OpenMP team,
+ * each thread on its own copy of the board. A table is shared by all threads.
+ */
+std::uint64_t perftParallel(const chess::Board& board, int depth, PerftTable* table = nullptr);
+
+#endif // PERFT_HPP
@@ -0,0 +1,86 @@
+/**
+ * @file PerftSuite.cpp
+ * @brief Runs perft over the standard suite for every mode and thread count, checks the node counts
+ * against the published ones and prints a CSV row per run. Exits with a nonzero status on a mismatch.
+ *
+ * Usage: perft [depth]
+ */
+
+#include "Perft.hpp"
+#include <omp.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[])
+{
+    int depth = 4;
+    // Parse command-line argument for depth if one is given
+    if (argc > 1) {
+        try {
+            depth = std::stoi(argv[1]);
+        } catch (const std::invalid_argument & e) {
+            std::cerr << "std::invalid_argument::what() " << e.what() << std::endl;
+        } catch (const std::out_of_range & e) {
+            std::cerr << "std::out_of_range::what() " << e.what() << std::endl;
+        }
+    }
+    if (depth < 1) {
+        std::cerr << "Depth must be at least 1." << std::endl;
+        return 1;
+    }
+
+    // Powers of two up to the size of the team, and the size of the team itself
+    std::vector<int> threadCounts;
+    const int maxThreads = omp_get_max_threads();
+    for (int numThreads = 1; numThreads < maxThreads; numThreads *= 2) {
+        threadCounts.push_back(numThreads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    int failures = 0;
+    std::cout << "position,mode,num_threads,depth,nodes,expected,correct,time_ms,nodes_per_sec" << std::endl;
+    for (const auto& position : perftSuite()) {
+        GameNode root(position.fen);
+        for (const std::string mode : {"tree", "board", "hashed"}) {
+            const int modeDepth = std::min<int>(mode == "tree" ? std::min(depth, perft_constants::MAX_TREE_DEPTH) : depth, position.nodes.size());
+            for (int numThreads : threadCounts) {
+                omp_set_num_threads(numThreads);
+                PerftTable table;
+                std::function<std::uint64_t()> run;
+                if (mode == "tree") {
+                    run = [&]() { return numThreads == 1 ? perft(root, modeDepth) : perftParallel(root, modeDepth); };
+                } else {
+                    auto* runTable = (mode == "hashed") ? &table : nullptr;
+                    run = [&, runTable]() {
+                        chess::Board board = root.board();
+                        return numThreads == 1 ? perft(board, modeDepth, runTable) : perftParallel(board, modeDepth, runTable);
+                    };
+                }
+
+                auto start = std::chrono::steady_clock::now();
+                auto nodes = run();
+                std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+                auto expected = position.nodes[modeDepth - 1];
+                failures += (nodes != expected);
+                std::cout << position.name
+                          << "," << mode
+                          << "," << numThreads
+                          << "," << modeDepth
+                          << "," << nodes
+                          << "," << expected
+                          << "," << (nodes == expected ? 1 : 0)
+                          << "," << elapsed.count() * 1000.0
+                          << "," << static_cast<std::uint64_t>(nodes / std::max(elapsed.count(), 1e-9))
+                          << std::endl;
+            }
+        }
+    }
+    if (failures) {
+        std::cerr << failures << " perft mismatches detected." << std::endl;
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file Ponder.cpp
+ */
+
+#include "Ponder.hpp"
+#include <omp.h>
+
+#include <algorithm>
+
+Ponderer::Ponderer(TranspositionTable* table)
+    : table_(table)
+    , done_(false)
+    , completedDepth_(0)
+    , result_{chess::Move(chess::Move::NO_MOVE), 0}
+{
+    // Only completed depths are reported by the Lazy SMP policy, so ponderhit can wait for a depth
+    context_.setCallback([this](const SearchProgress& progress) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        completedDepth_ = std::max(completedDepth_, progress.depth);
+        finished_.notify_all();
+    });
+}
+
+Ponderer::~Ponderer()
+{
+    stop();
+}
+
+void
+Ponderer::start(const GameNode& gameNode, const chess::Move& predictedReply, const SearchLimits& limits)
+{
+    stop();
+    position_ = std::make_unique<GameNode>(gameNode.board(), predictedReply);
+    context_.setNodeLimit(0);
+    context_.reset();
+    done_ = false;
+    completedDepth_ = 0;
+
+    // The search has no budget until ponderhit, so it runs until it reaches its depth or is stopped
+    const auto depth = static_cast<std::uint8_t>(std::clamp<int>(limits.depth, 1, search_constants::MAX_DEPTH));
+    const int numThreads = omp_get_max_threads();
+    thread_ = std::thread([this, depth, numThreads]() {
+        // The thread count is an ICV of each thread, so the team is sized like that of the caller
+        omp_set_num_threads(numThreads);
+        auto result = alphaBeta(
+            LazySMPTag{},
+            *position_,
+            depth,
+            -score_constants::INFINITE_SCORE,
+            score_constants::INFINITE_SCORE,
+            true,
+            table_,
+            &context_
+        );
+        std::lock_guard<std::mutex> lock(mutex_);
+        result_ = result;
+        done_ = true;
+        finished_.notify_all();
+    });
+}
+
+AlphaBetaResult
+Ponderer::ponderhit(const SearchLimits& limits)
+{
+    if (!thread_.joinable()) {
+        return {chess::Move(chess::Move::NO_MOVE), 0};
+    }
+    {
+        // Nodes are only counted once a limit is set, so the node budget starts from now
+        std::unique_lock<std::mutex> lock(mutex_);
+        context_.setNodeLimit(limits.nodes);
+        auto isDone = [this, &limits]() { return done_ || completedDepth_ >= limits.depth; };
+        if (limits.moveTime > std::chrono::milliseconds::zero()) {
+            finished_.wait_for(lock, limits.moveTime, isDone);
+        } else {
+            finished_.wait(lock, isDone);
+        }
+    }
+    context_.stop();
+    thread_.join();
+    return result_;
+}
+
+void
+Ponderer::stop()
+{
+    if (thread_.joinable()) {
+        context_.stop();
+        thread_.join();
+    }
+}
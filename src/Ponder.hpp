@@ -0,0 +1,97 @@
+/**
+ * @file Ponder.hpp
+ */
+
+#ifndef PONDER_HPP
+#define PONDER_HPP
+
+#include "AlphaBeta.hpp"
+#include "GameNode.hpp"
+#include "Search.hpp"
+#include "SearchContext.hpp"
+#include "TranspositionTable.hpp"
+#include <chess.hpp>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * @class Ponderer
+ * @brief Searches the position after the predicted reply of the opponent with the Lazy SMP policy on
+ * background threads while the engine waits for the opponent to move. If the opponent plays the
+ * predicted reply, ponderhit turns the running search into the real one and only waits for the remaining
+ * budget. Otherwise stop discards it, although the results it stored in the shared transposition table
+ * remain available to the next search.
+ */
+class Ponderer
+{
+    public:
+        // Delete copy constructor and assignment operator
+        Ponderer(const Ponderer&) = delete;
+        Ponderer& operator=(const Ponderer&) = delete;
+
+        /**
+         * @brief Constructor.
+         *
+         * @param table Transposition table shared with the searches of the engine, or nullptr to search
+         * without one.
+         */
+        explicit Ponderer(TranspositionTable* table = nullptr);
+
+        /**
+         * @brief Destructor. Stops any running search.
+         */
+        ~Ponderer();
+
+        /**
+         * @brief Start searching in the background with as many threads as the OpenMP thread count of the
+         * calling thread. Any running search is stopped first.
+         *
+         * @param gameNode Position after the move of the engine.
+         * @param predictedReply Expected reply of the opponent, typically the second move of the
+         * principal variation.
+         * @param limits Depth limit of the search. Time and node budgets are ignored until ponderhit.
+         */
+        void start(const GameNode& gameNode, const chess::Move& predictedReply, const SearchLimits& limits = SearchLimits());
+
+        /**
+         * @brief The opponent played the predicted reply: wait until the running search completes, reaches
+         * the depth limit, or exhausts the time or node budget counted from now.
+         *
+         * @param limits Depth, time and node budget of the real search. Without a budget, the search runs to
+         * the shallower of its depth limits.
+         *
+         * @return Result of the deepest completed iteration, relative to the side to move after the reply.
+         */
+        AlphaBetaResult ponderhit(const SearchLimits& limits);
+
+        /**
+         * @brief The opponent played another move: end the running search and discard its result.
+         */
+        void stop();
+
+        /**
+         * @brief Whether a search is running in the background.
+         */
+        bool isPondering() const { return thread_.joinable(); }
+
+        /**
+         * @brief Position being searched, after the predicted reply.
+         */
+        const GameNode& position() const { return *position_; }
+
+    private:
+        TranspositionTable* table_;
+        std::unique_ptr<GameNode> position_;
+        std::thread thread_;
+        SearchContext context_;
+        std::mutex mutex_;
+        std::condition_variable finished_;
+        bool done_;
+        int completedDepth_;
+        AlphaBetaResult result_;
+}; // class Ponderer
+
+#endif // PONDER_HPP
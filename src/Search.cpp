@@ -0,0 +1,482 @@
+/**
+ * @file Search.cpp
+ */
+
+#include "Search.hpp"
+#include "SearchStats.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace { // anonymous namespace
+    /**
+     * @brief Convert a mate score relative to the root into one relative to the current position
+     * before storing it, so that it remains valid when the position is reached at another ply.
+     */
+    std::int16_t scoreToTable(std::int16_t score, int ply) {
+        if (score >= score_constants::MATE_BOUND) return score + ply;
+        if (score <= -score_constants::MATE_BOUND) return score - ply;
+        return score;
+    }
+
+    /**
+     * @brief Convert a stored mate score back into one relative to the root.
+     */
+    std::int16_t scoreFromTable(std::int16_t score, int ply) {
+        if (score >= score_constants::MATE_BOUND) return score - ply;
+        if (score <= -score_constants::MATE_BOUND) return score + ply;
+        return score;
+    }
+} // end anonymous namespace
+
+SearchWorker::SearchWorker(const chess::Board& board, TranspositionTable* table)
+    : board_(board)
+    , evaluator_(board)
+    , table_(table)
+    , stop_(nullptr)
+    , context_(nullptr)
+    , hasLimits_(false)
+    , aborted_(false)
+    , maxNodes_(0)
+    , pollCounter_(0)
+    , polledNodes_(0)
+    , helperIndex_(0)
+    , ordering_(search_constants::MAX_PLY)
+    , movelists_(search_constants::MAX_PLY)
+    , nodesExplored_(0)
+{
+    if (table_ != nullptr) {
+        table_->bindScale(ScoreScale::CENTIPAWNS);
+    }
+}
+
+void
+SearchWorker::setLimits(std::chrono::steady_clock::time_point deadline, size_t maxNodes)
+{
+    hasLimits_ = true;
+    deadline_ = deadline;
+    maxNodes_ = maxNodes;
+}
+
+void
+SearchWorker::pollLimits()
+{
+    if (context_ != nullptr) {
+        if (context_->poll(nodesExplored_ - polledNodes_)) {
+            aborted_ = true;
+        }
+        polledNodes_ = nodesExplored_;
+    }
+    if (!hasLimits_) {
+        return;
+    }
+    if (maxNodes_ > 0 && nodesExplored_ >= maxNodes_) {
+        aborted_ = true;
+    }
+    // Reading the clock at every node would cost more than the search itself
+    if ((++pollCounter_ & 0x7FF) == 0 && std::chrono::steady_clock::now() >= deadline_) {
+        aborted_ = true;
+    }
+    // Other threads searching with the same context stop together with this one
+    if (aborted_ && context_ != nullptr) {
+        context_->stop();
+    }
+}
+
+void
+SearchWorker::makeMove(const chess::Move& move)
+{
+    evaluator_.makeMove(board_, move);
+    board_.makeMove(move);
+}
+
+void
+SearchWorker::unmakeMove(const chess::Move& move)
+{
+    board_.unmakeMove(move);
+    evaluator_.unmakeMove();
+}
+
+int
+SearchWorker::numNonPawnPieces() const
+{
+    const auto side = board_.sideToMove();
+    return (board_.us(side) ^ board_.pieces(chess::PieceType::PAWN, side) ^ board_.pieces(chess::PieceType::KING, side)).count();
+}
+
+void
+SearchWorker::makeNullMove()
+{
+    evaluator_.makeNullMove();
+    board_.makeNullMove();
+}
+
+void
+SearchWorker::unmakeNullMove()
+{
+    board_.unmakeNullMove();
+    evaluator_.unmakeNullMove();
+}
+
+bool
+SearchWorker::isDraw() const
+{
+    return board_.isHalfMoveDraw() || board_.isInsufficientMaterial() || board_.isRepetition(1);
+}
+
+std::int16_t
+SearchWorker::quiescence(int ply, std::int16_t alpha, std::int16_t beta)
+{
+    ++nodesExplored_;
+    stats::quiescenceNode();
+    if (isDraw()) {
+        return 0;
+    }
+    if (ply >= search_constants::MAX_PLY) {
+        return evaluator_.evaluate(board_);
+    }
+
+    // A side in check cannot stand pat, so every evasion is searched instead of only captures
+    auto& movelist = movelists_[ply];
+    movelist.clear();
+    const bool inCheck = board_.inCheck();
+    std::int16_t bestScore = -score_constants::INFINITE_SCORE;
+    if (inCheck) {
+        chess::movegen::legalmoves(movelist, board_);
+        if (movelist.empty()) {
+            return -score_constants::MATE_SCORE + ply;
+        }
+    } else {
+        bestScore = evaluator_.evaluate(board_);
+        if (bestScore >= beta) {
+            return bestScore;
+        }
+        alpha = std::max(alpha, bestScore);
+        chess::movegen::legalmoves<chess::movegen::MoveGenType::CAPTURE>(movelist, board_);
+    }
+    ordering_.orderMoves(movelist, board_, ply, chess::Move(chess::Move::NO_MOVE));
+
+    const auto standPat = bestScore;
+    for (const auto& move : movelist) {
+        // Delta pruning: skip captures that leave the evaluation short of alpha even with a margin
+        if (!inCheck && move.typeOf() != chess::Move::PROMOTION) {
+            auto victim = move.typeOf() == chess::Move::ENPASSANT
+                ? chess::PieceType(chess::PieceType::PAWN)
+                : board_.at<chess::PieceType>(move.to());
+            if (standPat + Evaluator::pieceValue(victim) + score_constants::DELTA_MARGIN <= alpha) {
+                continue;
+            }
+        }
+        makeMove(move);
+        std::int16_t score = -quiescence(ply + 1, -beta, -alpha);
+        unmakeMove(move);
+        if (stopped()) {
+            return 0;
+        }
+        bestScore = std::max(bestScore, score);
+        alpha = std::max(alpha, bestScore);
+        if (beta <= alpha) {
+            break;
+        }
+    }
+    return bestScore;
+}
+
+AlphaBetaResult
+SearchWorker::searchRoot(int depth, std::int16_t alpha, std::int16_t beta, chess::Move firstMove)
+{
+    auto startNodes = nodesExplored_;
+    stats::node(depth);
+    if (depth == 0) {
+        chess::Move move(chess::Move::NO_MOVE);
+        move.setScore(quiescence(0, alpha, beta));
+        return {move, nodesExplored_ - startNodes};
+    }
+
+    // Return if there are no legal moves remaining
+    auto& movelist = movelists_[0];
+    movelist.clear();
+    chess::movegen::legalmoves(movelist, board_);
+    if (movelist.empty()) {
+        chess::Move move(chess::Move::NO_MOVE);
+        move.setScore(board_.inCheck() ? -score_constants::MATE_SCORE : 0);
+        ++nodesExplored_;
+        return {move, 1};
+    }
+
+    // Search the best move of a previous search first, but never cut off at the root
+    TableEntry entry;
+    if (firstMove.move() == chess::Move::NO_MOVE && table_ != nullptr && table_->probe(board_.hash(), entry)) {
+        firstMove = entry.move;
+    }
+    ordering_.orderMoves(movelist, board_, 0, firstMove);
+    if (helperIndex_ > 0 && movelist.size() > 2) {
+        std::rotate(movelist.begin() + 1, movelist.begin() + 1 + helperIndex_ % (movelist.size() - 1), movelist.end());
+    }
+
+    auto alphaOrig = alpha;
+    chess::Move bestMove(chess::Move::NO_MOVE);
+    bestMove.setScore(-score_constants::INFINITE_SCORE);
+    stats::interiorNode();
+    for (const auto& move : movelist) {
+        makeMove(move);
+        std::int16_t score = searchMove<true>(depth - 1, 1, alpha, beta, move == movelist[0]);
+        unmakeMove(move);
+        if (stopped()) {
+            return {bestMove, nodesExplored_ - startNodes};
+        }
+        if (score > bestMove.score()) {
+            bestMove = move;
+            bestMove.setScore(score);
+        }
+        alpha = std::max(alpha, bestMove.score());
+        if (beta <= alpha) {
+            stats::cutoff(move == movelist[0]);
+            break;
+        }
+    }
+
+    if (table_ != nullptr) {
+        auto bound = classifyBound(bestMove.score(), alphaOrig, beta);
+        table_->store(board_.hash(), depth, scoreToTable(bestMove.score(), 0), bound, bestMove);
+    }
+    return {bestMove, nodesExplored_ - startNodes};
+}
+
+template<bool IsPV>
+std::int16_t
+SearchWorker::search(int depth, int ply, std::int16_t alpha, std::int16_t beta, bool allowNullMove)
+{
+    // Resolve captures if the maximum depth has been explored or the ply stack is exhausted
+    if (depth == 0 || ply >= search_constants::MAX_PLY) {
+        return quiescence(ply, alpha, beta);
+    }
+    pollLimits();
+    if (stopped()) {
+        return 0;
+    }
+    stats::node(depth);
+    if (isDraw()) {
+        ++nodesExplored_;
+        return 0;
+    }
+
+    // Reuse a stored result if it is deep enough to decide this node against the current window
+    TableEntry entry;
+    chess::Move hashMove(chess::Move::NO_MOVE);
+    bool found = false;
+    if (table_ != nullptr) {
+        found = table_->probe(board_.hash(), entry);
+        stats::tableProbe(found);
+    }
+    if (found) {
+        auto score = scoreFromTable(entry.score, ply);
+        if (entry.depth >= depth
+            && (entry.bound == Bound::EXACT
+                || (entry.bound == Bound::LOWER && score >= beta)
+                || (entry.bound == Bound::UPPER && score <= alpha))) {
+            ++nodesExplored_;
+            return score;
+        }
+        hashMove = entry.move;
+    }
+
+    // Null-move pruning: a position that still fails high when the side to move passes, searched
+    // shallower, would fail high after a real move too. This fails in zugzwang, where every move makes
+    // the position worse, so it is not tried with pawns alone and verified with a reduced search of the
+    // position itself when few pieces remain.
+    const bool inCheck = board_.inCheck();
+    if (allowNullMove && !inCheck && depth >= search_constants::NULL_MOVE_MIN_DEPTH && !IsPV
+        && std::abs(beta) < score_constants::MATE_BOUND) {
+        const int numPieces = numNonPawnPieces();
+        if (numPieces > 0 && evaluator_.evaluate(board_) >= beta) {
+            const int reduction = search_constants::NULL_MOVE_REDUCTION + (depth >= search_constants::NULL_MOVE_DEEP_DEPTH);
+            makeNullMove();
+            std::int16_t score = -search<false>(depth - 1 - reduction, ply + 1, -beta, -beta + 1, false);
+            unmakeNullMove();
+            if (stopped()) {
+                return 0;
+            }
+            if (score >= beta
+                && (numPieces > search_constants::NULL_MOVE_VERIFY_PIECES
+                    || search<false>(depth - reduction, ply, beta - 1, beta, false) >= beta)) {
+                // A mate found by passing is not a proof of mate
+                return score >= score_constants::MATE_BOUND ? beta : score;
+            }
+            if (stopped()) {
+                return 0;
+            }
+        }
+    }
+
+    // Moves of this ply live in the preallocated stack so that no allocation happens per node
+    auto& movelist = movelists_[ply];
+    movelist.clear();
+    chess::movegen::legalmoves(movelist, board_);
+    if (movelist.empty()) {
+        ++nodesExplored_;
+        return inCheck ? -score_constants::MATE_SCORE + ply : 0;
+    }
+    ordering_.orderMoves(movelist, board_, ply, hashMove);
+
+    auto alphaOrig = alpha;
+    chess::Move bestMove(chess::Move::NO_MOVE);
+    std::int16_t bestScore = -score_constants::INFINITE_SCORE;
+    stats::interiorNode();
+    int moveNumber = 0;
+    for (const auto& move : movelist) {
+        // Late move reductions: quiet moves ordered late rarely raise alpha, so they are searched
+        // shallower first. Evasions and moves that give check are searched to full depth.
+        int reduction = 0;
+        if (moveNumber >= search_constants::LMR_MIN_MOVES && depth >= search_constants::LMR_MIN_DEPTH && !inCheck
+            && !board_.isCapture(move) && move.typeOf() != chess::Move::PROMOTION) {
+            reduction = 1 + (moveNumber >= search_constants::LMR_LATE_MOVES && depth >= search_constants::LMR_DEEP_DEPTH);
+        }
+        makeMove(move);
+        if (reduction > 0 && board_.inCheck()) {
+            reduction = 0;
+        }
+        std::int16_t score = searchMove<IsPV>(depth - 1, ply + 1, alpha, beta, moveNumber == 0, reduction);
+        unmakeMove(move);
+        ++moveNumber;
+        if (stopped()) {
+            return 0;
+        }
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = move;
+        }
+        alpha = std::max(alpha, bestScore);
+        if (beta <= alpha) {
+            stats::cutoff(move == movelist[0]);
+            ordering_.updateCutoff(board_, move, ply, depth);
+            break;
+        }
+    }
+
+    if (table_ != nullptr) {
+        auto bound = classifyBound(bestScore, alphaOrig, beta);
+        table_->store(board_.hash(), depth, scoreToTable(bestScore, ply), bound, bestMove);
+    }
+    return bestScore;
+}
+
+template<bool IsPV>
+std::int16_t
+SearchWorker::searchMove(int depth, int ply, std::int16_t alpha, std::int16_t beta, bool isFirst, int reduction)
+{
+    if (IsPV && isFirst) {
+        return -search<IsPV>(depth, ply, -beta, -alpha);
+    }
+    // A reduced move is searched again at full depth only if it raises alpha
+    if (reduction > 0) {
+        std::int16_t score = -search<false>(depth - reduction, ply, -alpha - 1, -alpha);
+        if (score <= alpha || stopped()) {
+            return score;
+        }
+    }
+    // Later moves are expected to be worse, which a null window proves with far more cutoffs. Below a
+    // null window this is the window itself, which no score can fall strictly inside.
+    std::int16_t score = -search<false>(depth, ply, -alpha - 1, -alpha);
+    if constexpr (IsPV) {
+        if (score > alpha && score < beta && !stopped()) {
+            score = -search<true>(depth, ply, -beta, -alpha);
+        }
+    }
+    return score;
+}
+
+AlphaBetaResult
+SearchWorker::searchAspiration(int depth, std::int16_t guess, std::int16_t alpha, std::int16_t beta, chess::Move firstMove)
+{
+    // Mate scores and shallow iterations are too unstable for a narrow window to pay off
+    if (depth < search_constants::MIN_ASPIRATION_DEPTH || std::abs(guess) >= score_constants::MATE_BOUND) {
+        return searchRoot(depth, alpha, beta, firstMove);
+    }
+
+    int delta = search_constants::ASPIRATION_WINDOW;
+    std::int16_t windowAlpha = std::max<int>(alpha, guess - delta);
+    std::int16_t windowBeta = std::min<int>(beta, guess + delta);
+    AlphaBetaResult result{chess::Move(chess::Move::NO_MOVE), 0};
+    while (true) {
+        auto windowResult = searchRoot(depth, windowAlpha, windowBeta, firstMove);
+        result.nodesExplored += windowResult.nodesExplored;
+        result.bestMove = windowResult.bestMove;
+        if (stopped()) {
+            break;
+        }
+        auto score = windowResult.bestMove.score();
+        delta *= 2;
+        if (score <= windowAlpha && windowAlpha > alpha) {
+            windowAlpha = std::max<int>(alpha, score - delta);
+        } else if (score >= windowBeta && windowBeta < beta) {
+            // The move that failed high is likely best, so search it first again
+            windowBeta = std::min<int>(beta, score + delta);
+            firstMove = windowResult.bestMove;
+        } else {
+            break;
+        }
+    }
+    return result;
+}
+
+AlphaBetaResult
+iterativeDeepening(const GameNode& gameNode, const SearchLimits& limits, TranspositionTable* table, SearchContext* context)
+{
+    const auto start = std::chrono::steady_clock::now();
+    auto deadline = limits.moveTime > std::chrono::milliseconds::zero()
+        ? start + limits.moveTime
+        : std::chrono::steady_clock::time_point::max();
+    const auto maxNodes = limits.nodes;
+    if (context != nullptr) {
+        deadline = std::min(deadline, context->deadline());
+    }
+    const bool hasLimits = deadline != std::chrono::steady_clock::time_point::max() || maxNodes > 0;
+    if (table != nullptr) {
+        table->newSearch();
+    }
+
+    SearchWorker worker(gameNode.board(), table);
+    const int maxDepth = std::min<int>(limits.depth, search_constants::MAX_DEPTH);
+    AlphaBetaResult result = worker.searchRoot(std::min(maxDepth, 1), -score_constants::INFINITE_SCORE, score_constants::INFINITE_SCORE);
+    if (context != nullptr) {
+        context->report(result.bestMove, std::min(maxDepth, 1), worker.nodesExplored());
+    }
+    worker.setContext(context);
+    for (int depth = 2; depth <= maxDepth; ++depth) {
+        // A mate within the completed depth was found by a full-width search of every shorter line, so
+        // no shorter mate exists. Longer mates may still be shortened by searching deeper.
+        const int mateDistance = score_constants::MATE_SCORE - std::abs(result.bestMove.score());
+        if (std::abs(result.bestMove.score()) >= score_constants::MATE_BOUND && mateDistance <= depth - 1) {
+            break;
+        }
+        if (hasLimits) {
+            // An iteration takes several times as long as the previous one, so do not start one that
+            // is unlikely to finish before the deadline
+            auto now = std::chrono::steady_clock::now();
+            if (deadline != std::chrono::steady_clock::time_point::max() && now - start > (deadline - start) / 2) {
+                break;
+            }
+            if (maxNodes > 0 && worker.nodesExplored() >= maxNodes) {
+                break;
+            }
+            worker.setLimits(deadline, maxNodes);
+        }
+        auto iterationResult = worker.searchAspiration(
+            depth,
+            result.bestMove.score(),
+            -score_constants::INFINITE_SCORE,
+            score_constants::INFINITE_SCORE,
+            result.bestMove
+        );
+        if (worker.stopped()) {
+            break;
+        }
+        result.bestMove = iterationResult.bestMove;
+        if (context != nullptr) {
+            context->report(result.bestMove, depth, worker.nodesExplored());
+        }
+    }
+    result.nodesExplored = worker.nodesExplored();
+    return result;
+}
@@ -0,0 +1,289 @@
+/**
+ * @file Search.hpp
+ */
+
+#ifndef SEARCH_HPP
+#define SEARCH_HPP
+
+#include "AlphaBeta.hpp"
+#include "Evaluation.hpp"
+#include "GameNode.hpp"
+#include "MoveOrdering.hpp"
+#include "SearchContext.hpp"
+#include "TranspositionTable.hpp"
+#include <chess.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace search_constants {
+    // Maximum number of plies that a single search may descend from the root
+    constexpr int MAX_PLY = 128;
+
+    // Maximum depth of an iterative deepening search
+    constexpr std::uint8_t MAX_DEPTH = 64;
+
+    // Half width of the initial aspiration window around the score of the previous iteration, and
+    // the shallowest depth at which one is used
+    constexpr std::int16_t ASPIRATION_WINDOW = 25;
+    constexpr int MIN_ASPIRATION_DEPTH = 4;
+
+    // Null-move pruning is tried from this depth with the null move searched this much shallower, and
+    // one ply shallower still from the deep depth. A cutoff is verified with a reduced search when the
+    // side to move has at most this many pieces other than pawns.
+    constexpr int NULL_MOVE_MIN_DEPTH = 3;
+    constexpr int NULL_MOVE_REDUCTION = 2;
+    constexpr int NULL_MOVE_DEEP_DEPTH = 7;
+    constexpr int NULL_MOVE_VERIFY_PIECES = 1;
+
+    // Quiet moves after the first few are reduced by one ply from the minimum depth, and by two plies
+    // when they come later still at the deep depth
+    constexpr int LMR_MIN_MOVES = 3;
+    constexpr int LMR_MIN_DEPTH = 3;
+    constexpr int LMR_LATE_MOVES = 6;
+    constexpr int LMR_DEEP_DEPTH = 6;
+} // namespace search_constants
+
+// Budget for an iterative deepening search. A zero move time or node count means no limit.
+struct SearchLimits
+{
+    std::uint8_t depth = search_constants::MAX_DEPTH;
+    std::chrono::milliseconds moveTime = std::chrono::milliseconds::zero();
+    size_t nodes = 0;
+};
+
+/**
+ * @class SearchWorker
+ * @brief Per-thread search state for the make/unmake search path. A single board is advanced with
+ * makeMove and restored with unmakeMove as the search descends and returns, and the legal moves of
+ * each ply are generated into a preallocated stack of move lists, so no game tree is materialized.
+ * Scores are in centipawns from an evaluator that is updated alongside the board, and mates are
+ * scored by their distance from the root so that shorter mates are preferred. Below the root the
+ * search is selective, with null-move pruning and late move reductions.
+ */
+class SearchWorker
+{
+    public:
+        // Delete copy constructor and assignment operator
+        SearchWorker(const SearchWorker&) = delete;
+        SearchWorker& operator=(const SearchWorker&) = delete;
+
+        /**
+         * @brief Constructor.
+         *
+         * @param board Board position at the root of the search. The worker keeps its own copy.
+         * @param table Transposition table shared with other workers, or nullptr to search without one.
+         * The table is bound to centipawn scores.
+         */
+        explicit SearchWorker(const chess::Board& board, TranspositionTable* table = nullptr);
+
+        /**
+         * @brief Default destructor.
+         */
+        ~SearchWorker() = default;
+
+        /**
+         * @brief Negamax search with alpha-beta pruning from the root position.
+         *
+         * @param depth Depth to explore from the root.
+         * @param alpha Lower bound of the search window relative to the side to move at the root.
+         * @param beta Upper bound of the search window relative to the side to move at the root.
+         * @param firstMove Move to search first, typically the best move of the previous iteration.
+         *
+         * @return Best move at the root with its score relative to the side to move at the root.
+         */
+        AlphaBetaResult searchRoot(
+            int depth,
+            std::int16_t alpha,
+            std::int16_t beta,
+            chess::Move firstMove = chess::Move(chess::Move::NO_MOVE)
+        );
+
+        /**
+         * @brief Search from the root with an aspiration window centered on the score of a previous
+         * iteration. The window is widened exponentially on the failing side and the root searched
+         * again until the score falls inside it or the window reaches the outer bounds.
+         *
+         * @param depth Depth to explore from the root.
+         * @param guess Expected score relative to the side to move at the root.
+         * @param alpha Outer lower bound of the search window.
+         * @param beta Outer upper bound of the search window.
+         * @param firstMove Move to search first, typically the best move of the previous iteration.
+         *
+         * @return Best move at the root with its score relative to the side to move at the root.
+         */
+        AlphaBetaResult searchAspiration(
+            int depth,
+            std::int16_t guess,
+            std::int16_t alpha = -score_constants::INFINITE_SCORE,
+            std::int16_t beta = score_constants::INFINITE_SCORE,
+            chess::Move firstMove = chess::Move(chess::Move::NO_MOVE)
+        );
+
+        /**
+         * @brief Set a flag shared with other threads that aborts the search as soon as it is raised.
+         * A search that was aborted returns a meaningless result, which callers detect with stopped().
+         */
+        void setStopFlag(const std::atomic<bool>* stop) { stop_ = stop; }
+
+        /**
+         * @brief Abort the search once the context is stopped, and stop the context when the search
+         * aborts on its own limits. Explored nodes are counted by the context, so that its node and time
+         * limits apply to all workers searching with it together.
+         */
+        void setContext(SearchContext* context) { context_ = context; }
+
+        /**
+         * @brief Abort the search once the deadline has passed or the node budget is spent. The limits
+         * are polled periodically rather than at every node.
+         *
+         * @param deadline Point in time after which the search is aborted.
+         * @param maxNodes Number of nodes after which the search is aborted, or zero for no limit.
+         */
+        void setLimits(std::chrono::steady_clock::time_point deadline, size_t maxNodes);
+
+        /**
+         * @brief Whether the stop flag has been raised or a limit has been exceeded.
+         */
+        bool stopped() const {
+            return aborted_ || (stop_ != nullptr && stop_->load(std::memory_order_relaxed));
+        }
+
+        /**
+         * @brief Set the index of this worker among workers searching the same root. Workers other
+         * than the first rotate their root moves by their index so that they explore different
+         * subtrees first and fill a shared transposition table with complementary results.
+         */
+        void setHelperIndex(int helperIndex) { helperIndex_ = helperIndex; }
+
+        /**
+         * @brief Accessor for the board position currently held by the worker.
+         */
+        const chess::Board& board() const { return board_; }
+
+        /**
+         * @brief Accessor for the number of leaf nodes evaluated since construction.
+         */
+        size_t nodesExplored() const { return nodesExplored_; }
+
+    private:
+        /**
+         * @brief Recursive negamax search with alpha-beta pruning below the root. Moves after the first
+         * are searched with a null window around alpha and only searched again with the full window if
+         * they fail high, as in Principal Variation Search. The search is specialized on the node type:
+         * PV nodes are searched with an open window, and every node below a null window is a non-PV node,
+         * whose cut and all nodes share one specialization that first tries to fail high by passing the
+         * turn and never searches again.
+         *
+         * @tparam IsPV Whether the node is on the principal variation, searched with an open window.
+         * @param depth Remaining depth to explore.
+         * @param ply Distance from the root, used to index the move list stack.
+         * @param alpha Lower bound of the search window relative to the side to move.
+         * @param beta Upper bound of the search window relative to the side to move.
+         * @param allowNullMove Whether passing the turn may be tried, false right after a null move and
+         * in the search that verifies a null-move cutoff.
+         *
+         * @return Score of the current position relative to the side to move.
+         */
+        template<bool IsPV>
+        std::int16_t search(int depth, int ply, std::int16_t alpha, std::int16_t beta, bool allowNullMove = true);
+
+        /**
+         * @brief Search the position after a move has been made, scouting with a null window unless the
+         * move is the first of its node. Only the first move of a PV node and moves that fail high
+         * inside its window are searched as PV nodes.
+         *
+         * @tparam IsPV Whether the node the move was made from is a PV node.
+         * @param depth Remaining depth to explore below the move.
+         * @param ply Distance of the position after the move from the root.
+         * @param alpha Lower bound of the window relative to the side that made the move.
+         * @param beta Upper bound of the window relative to the side that made the move.
+         * @param isFirst Whether the move is the first, expected best, move of its node.
+         * @param reduction Plies by which a late move is first searched shallower with a null window.
+         *
+         * @return Score relative to the side that made the move.
+         */
+        template<bool IsPV>
+        std::int16_t searchMove(int depth, int ply, std::int16_t alpha, std::int16_t beta, bool isFirst, int reduction = 0);
+
+        /**
+         * @brief Quiescence search from a position at the horizon. The side to move may stand pat on
+         * the static evaluation or search captures and promotions until the position is quiet. In check
+         * every evasion is searched instead, which also tells checkmate apart. Captures that cannot
+         * bring the evaluation within a margin of alpha are pruned.
+         *
+         * @return Score of the current position relative to the side to move.
+         */
+        std::int16_t quiescence(int ply, std::int16_t alpha, std::int16_t beta);
+
+        /**
+         * @brief Whether the position is drawn by the fifty-move rule, insufficient material or a
+         * repetition of a position since the last irreversible move.
+         */
+        bool isDraw() const;
+
+        /**
+         * @brief Make or unmake a move on both the board and the evaluator.
+         */
+        void makeMove(const chess::Move& move);
+        void unmakeMove(const chess::Move& move);
+
+        /**
+         * @brief Pass or restore the turn on both the board and the evaluator.
+         */
+        void makeNullMove();
+        void unmakeNullMove();
+
+        /**
+         * @brief Number of pieces of the side to move other than pawns and the king.
+         */
+        int numNonPawnPieces() const;
+
+        /**
+         * @brief Count the nodes explored since the last call with the context and abort if it has been
+         * stopped, and check the deadline and node budget every few thousand calls and abort if exceeded.
+         */
+        void pollLimits();
+
+        chess::Board board_;
+        Evaluator evaluator_;
+        TranspositionTable* table_;
+        const std::atomic<bool>* stop_;
+        SearchContext* context_;
+        bool hasLimits_;
+        bool aborted_;
+        std::chrono::steady_clock::time_point deadline_;
+        size_t maxNodes_;
+        std::uint32_t pollCounter_;
+        size_t polledNodes_;
+        int helperIndex_;
+        MoveOrdering ordering_;
+        std::vector<chess::Movelist> movelists_;
+        size_t nodesExplored_;
+}; // class SearchWorker
+
+/**
+ * @brief Iterative deepening search on a single thread. Searches depth 1, 2, ... up to the depth limit
+ * with the best move of each iteration searched first in the next, and aborts the running iteration
+ * as soon as the time or node budget is exhausted or the context is stopped. The first iteration
+ * always completes so that a move is available, and every completed iteration is reported to the
+ * context.
+ *
+ * @param gameNode Root position of the search.
+ * @param limits Depth, time and node budget of the search. The limits of the context also apply.
+ * @param table Transposition table to use, or nullptr to search without one.
+ * @param context Context stopped by another thread to end the search early, or nullptr.
+ *
+ * @return Result of the last completed iteration with its score relative to the side to move, and the
+ * number of nodes explored over all iterations including the aborted one.
+ */
+AlphaBetaResult iterativeDeepening(
+    const GameNode& gameNode,
+    const SearchLimits& limits,
+    TranspositionTable* table = nullptr,
+    SearchContext* context = nullptr
+);
+
+#endif // SEARCH_HPP
@@ -0,0 +1,147 @@
+/**
+ * @file SearchContext.cpp
+ */
+
+#include "SearchContext.hpp"
+#include "SearchStats.hpp"
+
+namespace { // anonymous namespace
+    // Nodes polled by the calling thread since it last added them to the count of its context
+    struct PollCounter
+    {
+        unsigned epoch = 0;
+        size_t pending = 0;
+        std::uint32_t calls = 0;
+    };
+
+    thread_local PollCounter pollCounter;
+
+    // Nodes counted on a thread before they are added to the shared count
+    constexpr size_t NODE_BATCH = 256;
+
+    // Epochs are unique across contexts so that a thread can tell when its counter is stale
+    std::atomic<unsigned> nextEpoch(0);
+} // end anonymous namespace
+
+SearchContext::SearchContext()
+    : stop_(false)
+    , root_(nullptr)
+    , epoch_(0)
+    , nodeLimit_(0)
+    , moveTime_(std::chrono::milliseconds::zero())
+    , rootDepth_(0)
+    , rootNodes_(0)
+    , nodes_(0)
+{
+    reset();
+}
+
+void
+SearchContext::reset()
+{
+    stop_.store(false);
+    nodes_.store(0);
+    root_.store(nullptr);
+    epoch_.store(nextEpoch.fetch_add(1) + 1);
+    rootBest_ = chess::Move(chess::Move::NO_MOVE);
+    rootDepth_ = 0;
+    rootNodes_ = 0;
+    start_ = std::chrono::steady_clock::now();
+    setMoveTime(moveTime_);
+}
+
+void
+SearchContext::setMoveTime(std::chrono::milliseconds moveTime)
+{
+    moveTime_ = moveTime;
+    deadline_ = moveTime > std::chrono::milliseconds::zero()
+        ? start_ + moveTime
+        : std::chrono::steady_clock::time_point::max();
+}
+
+bool
+SearchContext::poll(size_t nodes)
+{
+    auto& counter = pollCounter;
+    const auto epoch = epoch_.load(std::memory_order_relaxed);
+    if (counter.epoch != epoch) {
+        counter = PollCounter{epoch, 0, 0};
+    }
+    const auto nodeLimit = nodeLimit_.load(std::memory_order_relaxed);
+    if (nodeLimit > 0) {
+        counter.pending += nodes;
+        if (counter.pending >= NODE_BATCH) {
+            nodes_.fetch_add(counter.pending, std::memory_order_relaxed);
+            counter.pending = 0;
+        }
+        if (nodes_.load(std::memory_order_relaxed) + counter.pending >= nodeLimit) {
+            stop();
+        }
+    }
+    // Reading the clock at every node would cost more than the search itself
+    if ((++counter.calls & 0x3FF) == 0 && std::chrono::steady_clock::now() >= deadline_) {
+        stop();
+    }
+    return stopped();
+}
+
+void
+SearchContext::report(const chess::Move& bestMove, int depth, size_t nodes)
+{
+    if (!callback_ || stopped()) {
+        return;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_;
+    SearchProgress progress{bestMove, bestMove.score(), depth, nodes, 0.0};
+    if (elapsed.count() > 0.0) {
+        progress.nodesPerSecond = nodes / elapsed.count();
+    }
+    stats::Stopwatch<> wait;
+    std::lock_guard<std::mutex> lock(callbackMutex_);
+    stats::lockWait(wait);
+
+    // Threads may complete depths out of order, and a shallower result is stale once a deeper one is out
+    if (depth < rootDepth_) {
+        return;
+    }
+    rootBest_ = bestMove;
+    rootDepth_ = depth;
+    callback_(progress);
+}
+
+void
+SearchContext::reportRootMove(const chess::Move& move, int depth, size_t nodes, bool isMaximizingPlayer)
+{
+    if (!callback_ || stopped()) {
+        return;
+    }
+    stats::Stopwatch<> wait;
+    std::lock_guard<std::mutex> lock(callbackMutex_);
+    stats::lockWait(wait);
+    rootNodes_ += nodes;
+    if (depth < rootDepth_) {
+        return;
+    }
+    const bool isBetter = isMaximizingPlayer ? move.score() > rootBest_.score() : move.score() < rootBest_.score();
+    if (depth > rootDepth_ || isBetter) {
+        rootBest_ = move;
+        rootDepth_ = depth;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_;
+    SearchProgress progress{rootBest_, rootBest_.score(), depth, rootNodes_, 0.0};
+    if (elapsed.count() > 0.0) {
+        progress.nodesPerSecond = rootNodes_ / elapsed.count();
+    }
+    callback_(progress);
+}
+
+bool
+SearchContext::enterRoot(const void* node)
+{
+    // Every node of a search asks, so test before the compare-and-swap that would contend for the line
+    const void* expected = nullptr;
+    if (root_.load(std::memory_order_relaxed) != nullptr) {
+        return false;
+    }
+    return root_.compare_exchange_strong(expected, node, std::memory_order_relaxed);
+}
@@ -0,0 +1,209 @@
+/**
+ * @file SearchContext.hpp
+ */
+
+#ifndef SEARCH_CONTEXT_HPP
+#define SEARCH_CONTEXT_HPP
+
+#include <chess.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+// Snapshot of a running search passed to progress callbacks
+struct SearchProgress
+{
+    chess::Move bestMove;
+    std::int16_t score;
+    int depth;
+    size_t nodes;
+    double nodesPerSecond;
+};
+
+/**
+ * @class SearchContext
+ * @brief State shared by all threads of a search and the thread that controls it. Any thread may raise
+ * the stop flag, and searches poll it together with the node and time limits of the context as they
+ * visit nodes, so that a search can be abandoned without waiting for it to complete. Searches report
+ * each searched root move with the best move so far, and each completed iteration or the end of a
+ * fixed-depth search, to the progress callback.
+ */
+class SearchContext
+{
+    public:
+        using ProgressCallback = std::function<void(const SearchProgress&)>;
+
+        // Delete copy constructor and assignment operator
+        SearchContext(const SearchContext&) = delete;
+        SearchContext& operator=(const SearchContext&) = delete;
+
+        /**
+         * @brief Constructor. The clock of the context starts immediately.
+         */
+        SearchContext();
+
+        /**
+         * @brief Restart the clock, lower the stop flag and clear the node count and best root move so
+         * that the context can be used for another search. Limits and callback are kept.
+         */
+        void reset();
+
+        /**
+         * @brief Limit the time of the search, counted from the last reset. Zero removes the limit.
+         */
+        void setMoveTime(std::chrono::milliseconds moveTime);
+
+        /**
+         * @brief Limit the number of nodes visited by the search. Zero removes the limit. A limit set while
+         * a search is running is counted from then on.
+         */
+        void setNodeLimit(size_t nodes) { nodeLimit_.store(nodes, std::memory_order_relaxed); }
+
+        /**
+         * @brief Set the function called with the progress of the search. Calls are serialized, but may
+         * come from any thread of the search.
+         */
+        void setCallback(ProgressCallback callback) { callback_ = std::move(callback); }
+
+        /**
+         * @brief Ask every thread of the search to stop as soon as possible.
+         */
+        void stop() { stop_.store(true, std::memory_order_relaxed); }
+
+        /**
+         * @brief Whether the search has been stopped or has exhausted its limits. Results of a stopped
+         * search are incomplete.
+         */
+        bool stopped() const { return stop_.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Stop flag of the context, for searches that poll a flag directly.
+         */
+        const std::atomic<bool>& stopFlag() const { return stop_; }
+
+        /**
+         * @brief Point in time at which the search must stop, or the maximum time point without a limit.
+         */
+        std::chrono::steady_clock::time_point deadline() const { return deadline_; }
+
+        /**
+         * @brief Maximum number of nodes to visit, or zero without a limit.
+         */
+        size_t nodeLimit() const { return nodeLimit_.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Count visited nodes, stop the search if a limit is exhausted, and report whether the
+         * search should stop. Nodes are only counted with a node limit, in thread-local batches that are
+         * added to the shared count every few hundred nodes, so the limit applies to all threads together
+         * and may be overshot by a batch per thread. The clock is only read every thousand calls on each
+         * thread.
+         *
+         * @param nodes Number of nodes visited since the last call on this thread.
+         */
+        bool poll(size_t nodes = 1);
+
+        /**
+         * @brief Number of nodes counted by poll since the last reset, excluding the batches not yet
+         * added by their threads. Always zero without a node limit.
+         */
+        size_t nodesCounted() const { return nodes_.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Report progress to the callback, if any, unless the search has been stopped or a deeper
+         * search has already been reported.
+         *
+         * @param bestMove Best move at the root with its score.
+         * @param depth Depth that has been completed.
+         * @param nodes Nodes explored so far by the whole search.
+         */
+        void report(const chess::Move& bestMove, int depth, size_t nodes);
+
+        /**
+         * @brief Report a searched move of the root, and report the best root move found so far at its
+         * depth to the callback, if any, unless the search has been stopped. May be called concurrently.
+         *
+         * @param move Root move with its score.
+         * @param depth Depth that the root is being searched to.
+         * @param nodes Nodes explored below the move, added to the nodes of earlier root moves.
+         * @param isMaximizingPlayer Whether greater scores are better for the side to move at the root.
+         */
+        void reportRootMove(const chess::Move& move, int depth, size_t nodes, bool isMaximizingPlayer);
+
+        /**
+         * @brief Claim a game tree node as the root of the search if no root is set, so that a recursive
+         * policy can tell its outermost call apart.
+         *
+         * @return Whether the node was claimed.
+         */
+        bool enterRoot(const void* node);
+
+        /**
+         * @brief Whether a node is the root claimed by enterRoot.
+         */
+        bool isRoot(const void* node) const { return root_.load(std::memory_order_relaxed) == node; }
+
+        /**
+         * @brief Release the root claimed by enterRoot once the outermost call returns.
+         */
+        void leaveRoot() { root_.store(nullptr, std::memory_order_relaxed); }
+
+    private:
+        // Read by every thread at every node and rarely written
+        std::atomic<bool> stop_;
+        std::atomic<const void*> root_;
+        std::atomic<unsigned> epoch_;
+        std::chrono::steady_clock::time_point deadline_;
+        std::atomic<size_t> nodeLimit_;
+
+        std::chrono::steady_clock::time_point start_;
+        std::chrono::milliseconds moveTime_;
+        ProgressCallback callback_;
+        std::mutex callbackMutex_;
+
+        // Best root move of the deepest depth reported by reportRootMove, guarded by callbackMutex_
+        chess::Move rootBest_;
+        int rootDepth_;
+        size_t rootNodes_;
+
+        // Written by every thread with a node limit, so kept off the line of the stop flag
+        alignas(64) std::atomic<size_t> nodes_;
+}; // class SearchContext
+
+/**
+ * @class RootScope
+ * @brief Claims the root of a search context for the outermost call of a recursive policy and releases
+ * it on every return path.
+ */
+class RootScope
+{
+    public:
+        RootScope(SearchContext* context, const void* node)
+            : context_(context), isRoot_(context != nullptr && context->enterRoot(node)) {}
+        ~RootScope() { if (isRoot_) context_->leaveRoot(); }
+
+        /**
+         * @brief Report the result of the outermost call as a completed search of the given depth.
+         */
+        void complete(const chess::Move& bestMove, int depth, size_t nodes) const {
+            if (isRoot_) context_->report(bestMove, depth, nodes);
+        }
+
+        /**
+         * @brief Report a searched move of the outermost call with its score.
+         */
+        void searched(chess::Move move, std::int16_t score, int depth, size_t nodes, bool isMaximizingPlayer) const {
+            if (isRoot_) {
+                move.setScore(score);
+                context_->reportRootMove(move, depth, nodes, isMaximizingPlayer);
+            }
+        }
+
+    private:
+        SearchContext* context_;
+        bool isRoot_;
+}; // class RootScope
+
+#endif // SEARCH_CONTEXT_HPP
@@ -0,0 +1,204 @@
+/**
+ * @file SearchStats.cpp
+ */
+
+#include "SearchStats.hpp"
+#include <omp.h>
+
+#include <mutex>
+#include <numeric>
+
+namespace { // anonymous namespace
+    // Counters of live threads, and the merged counters of threads that have exited
+    struct StatsRegistry
+    {
+        std::mutex mutex;
+        std::vector<SearchStats*> live;
+        SearchStats retired;
+    };
+
+    StatsRegistry& registry() {
+        static StatsRegistry instance;
+        return instance;
+    }
+
+    // Counters of one thread, registered for as long as the thread runs
+    struct ThreadRecorder
+    {
+        ThreadRecorder() {
+            std::lock_guard<std::mutex> lock(registry().mutex);
+            registry().live.push_back(&stats);
+        }
+
+        ~ThreadRecorder() {
+            auto& instance = registry();
+            std::lock_guard<std::mutex> lock(instance.mutex);
+            instance.retired.merge(stats);
+            instance.live.erase(std::find(instance.live.begin(), instance.live.end(), &stats));
+        }
+
+        SearchStats stats;
+    };
+
+    // Nesting of busy scopes on the calling thread
+    thread_local int busyDepth = 0;
+
+    double ratio(size_t numerator, size_t denominator) {
+        return denominator == 0 ? 0.0 : static_cast<double>(numerator) / denominator;
+    }
+
+    double milliseconds(std::chrono::nanoseconds duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+} // end anonymous namespace
+
+size_t
+SearchStats::nodes() const
+{
+    return std::accumulate(nodesPerDepth.begin(), nodesPerDepth.end(), quiescenceNodes);
+}
+
+double
+SearchStats::cutoffRate() const
+{
+    return ratio(cutoffs, interiorNodes);
+}
+
+double
+SearchStats::firstMoveCutoffRate() const
+{
+    return ratio(firstMoveCutoffs, cutoffs);
+}
+
+double
+SearchStats::tableHitRate() const
+{
+    return ratio(tableHits, tableProbes);
+}
+
+void
+SearchStats::merge(const SearchStats& other)
+{
+    for (size_t depth = 0; depth < nodesPerDepth.size(); ++depth) {
+        nodesPerDepth[depth] += other.nodesPerDepth[depth];
+    }
+    quiescenceNodes += other.quiescenceNodes;
+    interiorNodes += other.interiorNodes;
+    cutoffs += other.cutoffs;
+    firstMoveCutoffs += other.firstMoveCutoffs;
+    tableProbes += other.tableProbes;
+    tableHits += other.tableHits;
+    splits += other.splits;
+    lockWait += other.lockWait;
+    threads.resize(std::max(threads.size(), other.threads.size()));
+    for (size_t i = 0; i < other.threads.size(); ++i) {
+        threads[i].busy += other.threads[i].busy;
+        threads[i].idle += other.threads[i].idle;
+    }
+}
+
+SearchStats
+searchStatistics()
+{
+    auto& instance = registry();
+    std::lock_guard<std::mutex> lock(instance.mutex);
+    SearchStats merged = instance.retired;
+    for (const auto* stats : instance.live) {
+        merged.merge(*stats);
+    }
+    return merged;
+}
+
+void
+resetSearchStatistics()
+{
+    auto& instance = registry();
+    std::lock_guard<std::mutex> lock(instance.mutex);
+    instance.retired = SearchStats{};
+    for (auto* stats : instance.live) {
+        *stats = SearchStats{};
+    }
+}
+
+void
+writeStatistics(std::ostream& out, const SearchStats& stats)
+{
+    out << "nodes: " << stats.nodes() << std::endl;
+    out << "nodes_per_depth:";
+    for (size_t depth = 0; depth < stats.nodesPerDepth.size(); ++depth) {
+        if (stats.nodesPerDepth[depth] > 0) {
+            out << " " << depth << "=" << stats.nodesPerDepth[depth];
+        }
+    }
+    out << std::endl;
+    out << "quiescence_nodes: " << stats.quiescenceNodes << std::endl;
+    out << "cutoff_rate: " << stats.cutoffRate() << std::endl;
+    out << "first_move_cutoff_rate: " << stats.firstMoveCutoffRate() << std::endl;
+    out << "table_hit_rate: " << stats.tableHitRate() << std::endl;
+    out << "splits: " << stats.splits << std::endl;
+    out << "lock_wait_ms: " << milliseconds(stats.lockWait) << std::endl;
+    for (size_t i = 0; i < stats.threads.size(); ++i) {
+        out << "thread_" << i << ": busy_ms=" << milliseconds(stats.threads[i].busy)
+            << " idle_ms=" << milliseconds(stats.threads[i].idle) << std::endl;
+    }
+}
+
+SearchStats&
+stats::threadStats()
+{
+    thread_local ThreadRecorder recorder;
+    return recorder.stats;
+}
+
+template<bool Enabled>
+stats::SplitTimer<Enabled>::SplitTimer(bool active, bool isSplit)
+    : active_(active && !omp_in_parallel() && omp_get_max_threads() > 1)
+    , start_(std::chrono::steady_clock::now())
+{
+    if (active_) {
+        threadStats().splits += isSplit;
+        busy_.resize(omp_get_max_threads(), std::chrono::nanoseconds::zero());
+    }
+}
+
+template<bool Enabled>
+stats::SplitTimer<Enabled>::~SplitTimer()
+{
+    if (!active_) {
+        return;
+    }
+    // Threads that never held a busy scope were idle for the whole region
+    const auto elapsed = std::chrono::steady_clock::now() - start_;
+    auto& threads = threadStats().threads;
+    threads.resize(std::max(threads.size(), busy_.size()));
+    for (size_t i = 0; i < busy_.size(); ++i) {
+        threads[i].busy += busy_[i];
+        threads[i].idle += std::max(std::chrono::nanoseconds::zero(), std::chrono::nanoseconds(elapsed - busy_[i]));
+    }
+}
+
+template<bool Enabled>
+stats::SplitTimer<Enabled>::BusyScope::BusyScope(SplitTimer& timer)
+    : timer_(timer)
+    , counting_(false)
+    , threadIdx_(omp_get_thread_num())
+    , start_(std::chrono::steady_clock::now())
+{
+    if (timer.active_) {
+        counting_ = busyDepth++ == 0 && threadIdx_ < static_cast<int>(timer.busy_.size());
+    }
+}
+
+template<bool Enabled>
+stats::SplitTimer<Enabled>::BusyScope::~BusyScope()
+{
+    if (!timer_.active_) {
+        return;
+    }
+    --busyDepth;
+    if (counting_) {
+        timer_.busy_[threadIdx_] += std::chrono::steady_clock::now() - start_;
+    }
+}
+
+template class stats::SplitTimer<true>;
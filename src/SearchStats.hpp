@@ -0,0 +1,247 @@
+/**
+ * @file SearchStats.hpp
+ */
+
+#ifndef SEARCH_STATS_HPP
+#define SEARCH_STATS_HPP
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace stats_constants {
+    // Statistics are only collected when compiled with SEARCH_STATS defined, as with make STATS=1.
+    // Otherwise every recording call below is empty.
+#ifdef SEARCH_STATS
+    constexpr bool ENABLED = true;
+#else
+    constexpr bool ENABLED = false;
+#endif
+
+    // Deepest remaining depth counted on its own, deeper nodes are counted with it
+    constexpr int MAX_DEPTH = 64;
+} // namespace stats_constants
+
+// Time a thread spent searching subtrees at the splits it took part in, and waiting for its team
+struct ThreadTime
+{
+    std::chrono::nanoseconds busy{0};
+    std::chrono::nanoseconds idle{0};
+};
+
+/**
+ * @struct SearchStats
+ * @brief Counters of the searches run since the statistics were last reset. Every thread counts into
+ * its own instance, and the instances are only merged when the statistics are read.
+ */
+struct SearchStats
+{
+    // Nodes entered at each remaining depth, where depth 0 holds the nodes at the horizon
+    std::array<size_t, stats_constants::MAX_DEPTH + 1> nodesPerDepth{};
+    size_t quiescenceNodes = 0;
+
+    // Nodes whose moves were searched, and how many of them failed high, on the first move or later.
+    // Siblings searched concurrently without an eldest-first phase have no first move, so cutoffs of
+    // SharedCutoffsTag, LocalCutoffsTag and BlendedCutoffsTag never count as first-move cutoffs.
+    size_t interiorNodes = 0;
+    size_t cutoffs = 0;
+    size_t firstMoveCutoffs = 0;
+
+    size_t tableProbes = 0;
+    size_t tableHits = 0;
+
+    // Points where work was handed to more than one thread: parallel regions entered with a team of
+    // threads outside any other, and task groups that spawned tasks. A task team itself is not a split.
+    size_t splits = 0;
+
+    // Time spent waiting to enter critical sections
+    std::chrono::nanoseconds lockWait{0};
+
+    // Busy and idle time at splits indexed by OpenMP thread number
+    std::vector<ThreadTime> threads;
+
+    // Nodes entered at any depth plus quiescence nodes, which counts a horizon node twice when its
+    // quiescence search runs
+    size_t nodes() const;
+    double cutoffRate() const;
+    double firstMoveCutoffRate() const;
+    double tableHitRate() const;
+
+    /**
+     * @brief Add the counters of another instance to this one.
+     */
+    void merge(const SearchStats& other);
+};
+
+/**
+ * @brief Merge the counters of all threads, including threads that have exited. Only meaningful while
+ * no search is running.
+ */
+SearchStats searchStatistics();
+
+/**
+ * @brief Reset the counters of all threads. Must not be called while a search is running.
+ */
+void resetSearchStatistics();
+
+/**
+ * @brief Write statistics as one "key: value" line per counter.
+ */
+void writeStatistics(std::ostream& out, const SearchStats& stats);
+
+namespace stats {
+    /**
+     * @brief Counters of the calling thread.
+     */
+    SearchStats& threadStats();
+
+    inline void node(int depth) {
+        if constexpr (stats_constants::ENABLED) {
+            ++threadStats().nodesPerDepth[std::min(depth, stats_constants::MAX_DEPTH)];
+        }
+    }
+
+    inline void quiescenceNode() {
+        if constexpr (stats_constants::ENABLED) {
+            ++threadStats().quiescenceNodes;
+        }
+    }
+
+    inline void interiorNode() {
+        if constexpr (stats_constants::ENABLED) {
+            ++threadStats().interiorNodes;
+        }
+    }
+
+    inline void cutoff(bool firstMove) {
+        if constexpr (stats_constants::ENABLED) {
+            auto& counters = threadStats();
+            ++counters.cutoffs;
+            counters.firstMoveCutoffs += firstMove;
+        }
+    }
+
+    inline void tableProbe(bool hit) {
+        if constexpr (stats_constants::ENABLED) {
+            auto& counters = threadStats();
+            ++counters.tableProbes;
+            counters.tableHits += hit;
+        }
+    }
+
+    inline void split() {
+        if constexpr (stats_constants::ENABLED) {
+            ++threadStats().splits;
+        }
+    }
+
+    /**
+     * @class Stopwatch
+     * @brief Time since construction, which is always zero when statistics are compiled out.
+     */
+    template<bool Enabled = stats_constants::ENABLED>
+    class Stopwatch
+    {
+        public:
+            std::chrono::nanoseconds elapsed() const { return std::chrono::steady_clock::now() - start_; }
+
+        private:
+            std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+    }; // class Stopwatch
+
+    template<>
+    class Stopwatch<false>
+    {
+        public:
+            std::chrono::nanoseconds elapsed() const { return std::chrono::nanoseconds::zero(); }
+    }; // class Stopwatch<false>
+
+    /**
+     * @brief Count the time since a stopwatch was started as time waiting for a lock.
+     */
+    inline void lockWait(const Stopwatch<>& stopwatch) {
+        if constexpr (stats_constants::ENABLED) {
+            threadStats().lockWait += stopwatch.elapsed();
+        }
+    }
+
+    /**
+     * @class SplitTimer
+     * @brief Busy and idle time of the threads of a parallel region. The owner constructs the timer
+     * before entering the region, every thread holds a busy scope while it searches a subtree in the
+     * region, and the destructor charges each thread of the team with its busy time and the rest of
+     * the region as idle time. Only regions entered outside any other parallel region are timed, since
+     * nested regions run on the thread that enters them unless nested parallelism is enabled.
+     */
+    template<bool Enabled = stats_constants::ENABLED>
+    class SplitTimer
+    {
+        public:
+            // Delete copy constructor and assignment operator
+            SplitTimer(const SplitTimer&) = delete;
+            SplitTimer& operator=(const SplitTimer&) = delete;
+
+            /**
+             * @brief Constructor.
+             *
+             * @param active Whether the region is timed, false for regions that run on a single thread.
+             * @param isSplit Whether the region hands the children of a node to its team and counts as a
+             * split, false for a team that splits in task groups, which count their own splits.
+             */
+            explicit SplitTimer(bool active, bool isSplit = true);
+
+            /**
+             * @brief Charge the threads of the team with their busy and idle time.
+             */
+            ~SplitTimer();
+
+            /**
+             * @class BusyScope
+             * @brief Busy time of the calling thread until destruction. Scopes nested on a thread, as
+             * when it executes another task while waiting for its own, are not counted twice.
+             */
+            class BusyScope
+            {
+                public:
+                    // Delete copy constructor and assignment operator
+                    BusyScope(const BusyScope&) = delete;
+                    BusyScope& operator=(const BusyScope&) = delete;
+
+                    explicit BusyScope(SplitTimer& timer);
+                    ~BusyScope();
+
+                private:
+                    SplitTimer& timer_;
+                    bool counting_;
+                    int threadIdx_;
+                    std::chrono::steady_clock::time_point start_;
+            }; // class BusyScope
+
+            BusyScope busy() { return BusyScope(*this); }
+
+        private:
+            bool active_;
+            std::chrono::steady_clock::time_point start_;
+            std::vector<std::chrono::nanoseconds> busy_;
+    }; // class SplitTimer
+
+    template<>
+    class SplitTimer<false>
+    {
+        public:
+            // Delete copy constructor and assignment operator
+            SplitTimer(const SplitTimer&) = delete;
+            SplitTimer& operator=(const SplitTimer&) = delete;
+
+            explicit SplitTimer([[maybe_unused]] bool active, [[maybe_unused]] bool isSplit = true) {}
+
+            // The empty destructor keeps the busy scopes held by the searches from being unused variables
+            struct BusyScope { ~BusyScope() {} };
+            BusyScope busy() { return {}; }
+    }; // class SplitTimer<false>
+} // namespace stats
+
+#endif // SEARCH_STATS_HPP
@@ -0,0 +1,168 @@
+/**
+ * @file TranspositionTable.cpp
+ */
+
+#include "TranspositionTable.hpp"
+#include <omp.h>
+
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+
+namespace { // anonymous namespace
+    // Layout of a packed entry: move (16 bits), score (16), depth (8), bound (2), generation (6)
+    constexpr int SCORE_SHIFT = 16, DEPTH_SHIFT = 32, BOUND_SHIFT = 40, GENERATION_SHIFT = 42;
+
+    std::uint64_t pack(chess::Move move, std::int16_t score, int depth, Bound bound, std::uint8_t generation) {
+        return static_cast<std::uint64_t>(move.move())
+            | static_cast<std::uint64_t>(static_cast<std::uint16_t>(score)) << SCORE_SHIFT
+            | static_cast<std::uint64_t>(static_cast<std::uint8_t>(depth)) << DEPTH_SHIFT
+            | static_cast<std::uint64_t>(bound) << BOUND_SHIFT
+            | static_cast<std::uint64_t>(generation) << GENERATION_SHIFT;
+    }
+
+    std::uint16_t unpackMove(std::uint64_t data) { return data & 0xFFFF; }
+    std::int16_t unpackScore(std::uint64_t data) { return static_cast<std::int16_t>((data >> SCORE_SHIFT) & 0xFFFF); }
+    std::uint8_t unpackDepth(std::uint64_t data) { return (data >> DEPTH_SHIFT) & 0xFF; }
+    Bound unpackBound(std::uint64_t data) { return static_cast<Bound>((data >> BOUND_SHIFT) & 0x3); }
+    std::uint8_t unpackGeneration(std::uint64_t data) { return (data >> GENERATION_SHIFT) & 0x3F; }
+} // end anonymous namespace
+
+TranspositionTable::TranspositionTable(size_t sizeMB, TablePlacement placement)
+    : numBuckets_(0)
+    , placement_(placement)
+    , generation_(0)
+    , scale_(ScoreScale::UNBOUND)
+{
+    resize(sizeMB);
+}
+
+void
+TranspositionTable::BucketDeleter::operator()(Bucket* buckets) const
+{
+    ::operator delete[](buckets, std::align_val_t(alignof(Bucket)));
+}
+
+void
+TranspositionTable::resize(size_t sizeMB)
+{
+    numBuckets_ = std::max<size_t>(1, sizeMB * 1024 * 1024 / sizeof(Bucket));
+    generation_ = 0;
+    scale_.store(ScoreScale::UNBOUND, std::memory_order_relaxed);
+
+    // A table constructed inside a parallel region belongs to the calling thread
+    const bool isPrivate = omp_in_parallel() || placement_ == TablePlacement::SHARED;
+    const int numCopies = (placement_ == TablePlacement::REPLICATED && !isPrivate) ? numa::numNodes() : 1;
+    copies_.clear();
+    for (int copy = 0; copy < numCopies; ++copy) {
+        void* memory = ::operator new[](numBuckets_ * sizeof(Bucket), std::align_val_t(alignof(Bucket)));
+        copies_.emplace_back(static_cast<Bucket*>(memory));
+    }
+    auto initialize = [this](int copy, size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            new (&copies_[copy][i]) Bucket();
+        }
+    };
+    if (isPrivate) {
+        initialize(0, 0, numBuckets_);
+        return;
+    }
+
+    // Every thread initializes a contiguous range of the copy of its node, so that the pages of the
+    // range are placed on that node when they are first touched
+    std::vector<int> threadCopies(omp_get_max_threads(), -1);
+    #pragma omp parallel
+    {
+        const int threadIdx = omp_get_thread_num();
+        const int copy = numa::currentNode() % numCopies;
+        threadCopies[threadIdx] = copy;
+        #pragma omp barrier
+        const auto rank = std::count(threadCopies.begin(), threadCopies.begin() + threadIdx, copy);
+        const auto numPeers = std::count(threadCopies.begin(), threadCopies.end(), copy);
+        initialize(copy, numBuckets_ * rank / numPeers, numBuckets_ * (rank + 1) / numPeers);
+    } // omp parallel
+
+    // Copies of nodes without threads are only probed by threads that migrate there later
+    for (int copy = 0; copy < numCopies; ++copy) {
+        if (std::find(threadCopies.begin(), threadCopies.end(), copy) == threadCopies.end()) {
+            initialize(copy, 0, numBuckets_);
+        }
+    }
+}
+
+void
+TranspositionTable::clear()
+{
+    for (const auto& buckets : copies_) {
+        for (size_t i = 0; i < numBuckets_; ++i) {
+            for (auto& slot : buckets[i].slots) {
+                slot.key.store(0, std::memory_order_relaxed);
+                slot.data.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+    generation_ = 0;
+    scale_.store(ScoreScale::UNBOUND, std::memory_order_relaxed);
+}
+
+void
+TranspositionTable::bindNewScale(ScoreScale scale)
+{
+    auto current = ScoreScale::UNBOUND;
+    if (!scale_.compare_exchange_strong(current, scale, std::memory_order_relaxed) && current != scale) {
+        throw std::logic_error("Transposition table is shared between searches of different score scales.");
+    }
+}
+
+bool
+TranspositionTable::probe(std::uint64_t key, TableEntry& entry) const
+{
+    for (const auto& slot : bucketFor(key).slots) {
+        auto data = slot.data.load(std::memory_order_relaxed);
+        // A slot only matches if both words were written by the same store
+        if ((slot.key.load(std::memory_order_relaxed) ^ data) != key || unpackBound(data) == Bound::NONE) {
+            continue;
+        }
+        entry.move = chess::Move(unpackMove(data));
+        entry.score = unpackScore(data);
+        entry.depth = unpackDepth(data);
+        entry.bound = unpackBound(data);
+        return true;
+    }
+    return false;
+}
+
+void
+TranspositionTable::store(std::uint64_t key, int depth, std::int16_t score, Bound bound, chess::Move move)
+{
+    auto& bucket = bucketFor(key);
+
+    // Prefer the slot already holding this position, otherwise the shallowest or oldest slot
+    Slot* replace = &bucket.slots[0];
+    int replaceValue = INT32_MAX;
+    for (auto& slot : bucket.slots) {
+        auto data = slot.data.load(std::memory_order_relaxed);
+        if ((slot.key.load(std::memory_order_relaxed) ^ data) == key) {
+            // Keep a deeper bound from the current search rather than overwriting it with a shallower one
+            if (bound != Bound::EXACT && depth + 2 < unpackDepth(data) && unpackGeneration(data) == generation_) {
+                return;
+            }
+            // Keep a known best move rather than overwriting it with nothing
+            if (move.move() == chess::Move::NO_MOVE) {
+                move = chess::Move(unpackMove(data));
+            }
+            replace = &slot;
+            break;
+        }
+        int age = (generation_ - unpackGeneration(data)) & GENERATION_MASK;
+        int value = unpackDepth(data) - 8 * age;
+        if (value < replaceValue) {
+            replaceValue = value;
+            replace = &slot;
+        }
+    }
+
+    auto data = pack(move, score, depth, bound, generation_);
+    replace->key.store(key ^ data, std::memory_order_relaxed);
+    replace->data.store(data, std::memory_order_relaxed);
+}
@@ -0,0 +1,192 @@
+/**
+ * @file TranspositionTable.hpp
+ */
+
+#ifndef TRANSPOSITION_TABLE_HPP
+#define TRANSPOSITION_TABLE_HPP
+
+#include "Numa.hpp"
+#include <chess.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Kind of bound that a stored score places on the true score of a position
+enum class Bound : std::uint8_t { NONE, EXACT, LOWER, UPPER };
+
+/**
+ * @brief Classify a fail-soft search result against the window it was searched with.
+ */
+inline Bound classifyBound(std::int16_t score, std::int16_t alpha, std::int16_t beta) {
+    if (score <= alpha) return Bound::UPPER;
+    if (score >= beta) return Bound::LOWER;
+    return Bound::EXACT;
+}
+
+// Scale of the scores stored in a table. Searches of GameNode trees score material in eval_constants
+// units, while SearchWorker searches score centipawns with mates adjusted by their distance, so each
+// would misread the entries of the other.
+enum class ScoreScale : std::uint8_t { UNBOUND, MATERIAL, CENTIPAWNS };
+
+// Result of a successful transposition table lookup
+struct TableEntry
+{
+    chess::Move move;
+    std::int16_t score;
+    std::uint8_t depth;
+    Bound bound;
+};
+
+/**
+ * @class TranspositionTable
+ * @brief Fixed-size hash table of search results keyed on the Zobrist hash of the board, shared by
+ * all threads without locks. Each slot holds two 64-bit words: the packed entry and the key XORed
+ * with the packed entry. A slot torn by concurrent writers fails the XOR check on lookup and is
+ * treated as a miss, so readers never observe a mixed entry. Slots are grouped into buckets of one
+ * cache line so that a lookup touches a single line. The memory of the table is placed across NUMA
+ * nodes as its TablePlacement describes. A table holds scores of a single ScoreScale, bound by the
+ * first search that uses it, and must not be shared between searches of GameNode trees and
+ * SearchWorker searches until it is cleared.
+ */
+class TranspositionTable
+{
+    public:
+        // Default size of the table in megabytes
+        static constexpr size_t DEFAULT_SIZE_MB = 16;
+
+        // Delete copy constructor and assignment operator
+        TranspositionTable(const TranspositionTable&) = delete;
+        TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+        /**
+         * @brief Constructor.
+         *
+         * @param sizeMB Size of the table, or of each copy of a replicated table, in megabytes.
+         * @param placement Placement of the table across NUMA nodes. A table constructed inside a
+         * parallel region belongs to its thread and is always a single copy touched by that thread.
+         */
+        explicit TranspositionTable(size_t sizeMB = DEFAULT_SIZE_MB, TablePlacement placement = numa::config().tables);
+
+        /**
+         * @brief Default destructor.
+         */
+        ~TranspositionTable() = default;
+
+        /**
+         * @brief Reallocate the table with a new size and the same placement, discarding all entries.
+         * Not thread-safe.
+         *
+         * @param sizeMB Size of the table, or of each copy of a replicated table, in megabytes.
+         */
+        void resize(size_t sizeMB);
+
+        /**
+         * @brief Discard all entries. Not thread-safe.
+         */
+        void clear();
+
+        /**
+         * @brief Advance the table generation so that entries from previous searches are replaced first.
+         * Called once before each new search from the root.
+         */
+        void newSearch() { generation_ = (generation_ + 1) & GENERATION_MASK; }
+
+        /**
+         * @brief Bind the table to the score scale of a search that uses it. The first search after the
+         * table is constructed, resized or cleared binds it.
+         *
+         * @throw std::logic_error if the table is already bound to another scale.
+         */
+        void bindScale(ScoreScale scale) {
+            if (scale_.load(std::memory_order_relaxed) != scale) {
+                bindNewScale(scale);
+            }
+        }
+
+        /**
+         * @brief Accessor for the score scale of the entries, which is unbound until a search uses the table.
+         */
+        ScoreScale scale() const { return scale_.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Look up a position.
+         *
+         * @param key Zobrist hash of the position.
+         * @param entry Filled with the stored entry if the position is found.
+         *
+         * @return Whether the position was found.
+         */
+        bool probe(std::uint64_t key, TableEntry& entry) const;
+
+        /**
+         * @brief Store a search result for a position, replacing the least valuable slot of its bucket.
+         *
+         * @param key Zobrist hash of the position.
+         * @param depth Depth that the position was searched to.
+         * @param score Score relative to the side to move.
+         * @param bound Kind of bound that the score places on the true score.
+         * @param move Best move found, or a null move if none is known.
+         */
+        void store(std::uint64_t key, int depth, std::int16_t score, Bound bound, chess::Move move);
+
+        /**
+         * @brief Accessor for the size of the table, or of each copy of a replicated table, in megabytes.
+         */
+        size_t sizeMB() const { return numBuckets_ * sizeof(Bucket) / (1024 * 1024); }
+
+        /**
+         * @brief Accessor for the placement of the table across NUMA nodes.
+         */
+        TablePlacement placement() const { return placement_; }
+
+        /**
+         * @brief Number of independent copies of the table, one per node if it is replicated.
+         */
+        size_t numCopies() const { return copies_.size(); }
+
+    private:
+        static constexpr int SLOTS_PER_BUCKET = 4;
+        static constexpr std::uint8_t GENERATION_MASK = 0x3F;
+
+        struct Slot
+        {
+            std::atomic<std::uint64_t> key{0};
+            std::atomic<std::uint64_t> data{0};
+        };
+
+        struct alignas(64) Bucket
+        {
+            Slot slots[SLOTS_PER_BUCKET];
+        };
+
+        // Buckets are allocated uninitialized so that the threads of their node touch them first
+        struct BucketDeleter
+        {
+            void operator()(Bucket* buckets) const;
+        };
+        using BucketArray = std::unique_ptr<Bucket[], BucketDeleter>;
+
+        /**
+         * @brief Bind an unbound table to a scale, or throw if it is bound to another.
+         */
+        void bindNewScale(ScoreScale scale);
+
+        /**
+         * @brief Map a key onto a bucket of the copy of the calling thread's node using the high bits of
+         * the product, which avoids a modulo.
+         */
+        Bucket& bucketFor(std::uint64_t key) const {
+            const auto& buckets = copies_.size() == 1 ? copies_.front() : copies_[numa::currentNode() % copies_.size()];
+            return buckets[static_cast<size_t>((static_cast<unsigned __int128>(key) * numBuckets_) >> 64)];
+        }
+
+        std::vector<BucketArray> copies_;
+        size_t numBuckets_;
+        TablePlacement placement_;
+        std::uint8_t generation_;
+        std::atomic<ScoreScale> scale_;
+}; // class TranspositionTable
+
+#endif // TRANSPOSITION_TABLE_HPP
@@ -0,0 +1,294 @@
+/**
+ * @file Uci.cpp
+ */
+
+#include "Uci.hpp"
+#include "Search.hpp"
+#include <omp.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+namespace { // anonymous namespace
+    /**
+     * @brief Format a score relative to the side to move as a UCI score, in moves to mate for mate scores.
+     */
+    std::string formatScore(std::int16_t score) {
+        if (score >= score_constants::MATE_BOUND) {
+            return "mate " + std::to_string((score_constants::MATE_SCORE - score + 1) / 2);
+        }
+        if (score <= -score_constants::MATE_BOUND) {
+            return "mate -" + std::to_string((score_constants::MATE_SCORE + score) / 2);
+        }
+        return "cp " + std::to_string(score);
+    }
+
+    /**
+     * @brief Time to spend on a move given the clock of the side to move, or zero without a clock.
+     */
+    std::chrono::milliseconds allocateTime(long long remaining, long long increment, int movesToGo) {
+        if (remaining <= 0) {
+            return std::chrono::milliseconds::zero();
+        }
+        auto budget = remaining / std::max(movesToGo, 1) + increment / 2;
+        budget = std::min(budget, remaining / 2) - uci_constants::MOVE_OVERHEAD_MS;
+        return std::chrono::milliseconds(std::max<long long>(budget, 1));
+    }
+} // end anonymous namespace
+
+UciEngine::UciEngine(std::istream& in, std::ostream& out)
+    : in_(in)
+    , out_(out)
+    , root_(std::make_unique<GameNode>())
+    , numThreads_(omp_get_max_threads())
+    , job_{search_constants::MAX_DEPTH, false}
+    , searching_(false)
+    , quit_(false)
+{
+    // Completed depths are streamed to the GUI as they arrive, from whichever thread completed them
+    context_.setCallback([this](const SearchProgress& progress) {
+        send("info depth " + std::to_string(progress.depth)
+             + " score " + formatScore(progress.score)
+             + " nodes " + std::to_string(progress.nodes)
+             + " nps " + std::to_string(static_cast<size_t>(progress.nodesPerSecond))
+             + " pv " + chess::uci::moveToUci(progress.bestMove));
+    });
+    searchThread_ = std::thread(&UciEngine::searchLoop, this);
+}
+
+UciEngine::~UciEngine()
+{
+    context_.stop();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        quit_ = true;
+    }
+    wake_.notify_one();
+    searchThread_.join();
+}
+
+void
+UciEngine::run()
+{
+    std::string line;
+    while (std::getline(in_, line)) {
+        if (!execute(line)) {
+            return;
+        }
+    }
+    if (job_.infinite) {
+        stopSearch();
+    }
+    waitForSearch();
+}
+
+bool
+UciEngine::execute(const std::string& line)
+{
+    std::istringstream tokens(line);
+    std::string command;
+    tokens >> command;
+    if (command == "uci") {
+        uci();
+    } else if (command == "isready") {
+        send("readyok");
+    } else if (command == "setoption") {
+        setOption(tokens);
+    } else if (command == "ucinewgame") {
+        waitForSearch();
+        table_.clear();
+    } else if (command == "position") {
+        position(tokens);
+    } else if (command == "go") {
+        go(tokens);
+    } else if (command == "stop") {
+        stopSearch();
+    } else if (command == "quit") {
+        stopSearch();
+        return false;
+    }
+    // Unknown commands are ignored as the protocol requires
+    return true;
+}
+
+void
+UciEngine::uci()
+{
+    send(std::string("id name ") + uci_constants::ENGINE_NAME);
+    send(std::string("id author ") + uci_constants::ENGINE_AUTHOR);
+    send("option name Hash type spin default " + std::to_string(TranspositionTable::DEFAULT_SIZE_MB)
+         + " min 1 max " + std::to_string(uci_constants::MAX_HASH_MB));
+    send("option name Threads type spin default " + std::to_string(omp_get_max_threads())
+         + " min 1 max " + std::to_string(uci_constants::MAX_THREADS));
+    send("uciok");
+}
+
+void
+UciEngine::setOption(std::istringstream& tokens)
+{
+    // setoption name <name> value <value>
+    std::string token, name, value;
+    tokens >> token >> name >> token >> value;
+    if (value.empty()) {
+        return;
+    }
+    waitForSearch();
+    if (name == "Hash") {
+        table_.resize(std::clamp(std::atoi(value.c_str()), 1, uci_constants::MAX_HASH_MB));
+    } else if (name == "Threads") {
+        numThreads_ = std::clamp(std::atoi(value.c_str()), 1, uci_constants::MAX_THREADS);
+    }
+}
+
+void
+UciEngine::position(std::istringstream& tokens)
+{
+    // position [startpos | fen <fen>] [moves <move> ...]
+    std::string token, fen;
+    tokens >> token;
+    if (token == "startpos") {
+        fen = chess::constants::STARTPOS;
+        tokens >> token;
+    } else if (token == "fen") {
+        while (tokens >> token && token != "moves") {
+            fen += token + " ";
+        }
+    } else {
+        return;
+    }
+
+    // The search thread reads the position, so it is only replaced between searches
+    waitForSearch();
+    root_ = std::make_unique<GameNode>(fen);
+    while (token == "moves" && tokens >> token) {
+        auto move = chess::uci::uciToMove(root_->board(), token);
+        chess::Movelist legalMoves;
+        chess::movegen::legalmoves(legalMoves, root_->board());
+        if (std::find(legalMoves.begin(), legalMoves.end(), move) == legalMoves.end()) {
+            break;
+        }
+        root_->makeMove(move);
+        token = "moves";
+    }
+}
+
+void
+UciEngine::go(std::istringstream& tokens)
+{
+    long long wtime = 0, btime = 0, winc = 0, binc = 0, moveTime = 0;
+    int movesToGo = uci_constants::DEFAULT_MOVES_TO_GO, depth = search_constants::MAX_DEPTH;
+    size_t nodes = 0;
+    bool infinite = false;
+    std::string token;
+    while (tokens >> token) {
+        if (token == "depth") tokens >> depth;
+        else if (token == "movetime") tokens >> moveTime;
+        else if (token == "wtime") tokens >> wtime;
+        else if (token == "btime") tokens >> btime;
+        else if (token == "winc") tokens >> winc;
+        else if (token == "binc") tokens >> binc;
+        else if (token == "movestogo") tokens >> movesToGo;
+        else if (token == "nodes") tokens >> nodes;
+        else if (token == "infinite") infinite = true;
+    }
+
+    // An infinite search ignores the clock and only ends on stop
+    if (infinite) {
+        wtime = btime = moveTime = 0;
+    }
+
+    waitForSearch();
+    const bool isWhite = root_->board().sideToMove() == chess::Color::WHITE;
+    auto budget = moveTime > 0
+        ? std::chrono::milliseconds(moveTime)
+        : allocateTime(isWhite ? wtime : btime, isWhite ? winc : binc, movesToGo);
+    context_.setMoveTime(budget);
+    context_.setNodeLimit(nodes);
+    context_.reset();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_.depth = static_cast<std::uint8_t>(std::clamp<int>(depth, 1, search_constants::MAX_DEPTH));
+        job_.infinite = infinite;
+        searching_ = true;
+    }
+    wake_.notify_one();
+}
+
+void
+UciEngine::waitForSearch()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this]() { return !searching_; });
+}
+
+void
+UciEngine::stopSearch()
+{
+    // The flag is raised before the lock is taken, so an infinite search either sees it or is waiting
+    context_.stop();
+    std::lock_guard<std::mutex> lock(mutex_);
+    wake_.notify_all();
+}
+
+void
+UciEngine::searchLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [this]() { return searching_ || quit_; });
+        if (quit_) {
+            return;
+        }
+        auto job = job_;
+        lock.unlock();
+        search(job);
+        lock.lock();
+        searching_ = false;
+        idle_.notify_all();
+    }
+}
+
+void
+UciEngine::search(const SearchJob& job)
+{
+    // The thread count is an ICV of this thread, which forks the team of every search
+    omp_set_num_threads(numThreads_);
+    auto result = alphaBeta(
+        LazySMPTag{},
+        *root_,
+        job.depth,
+        -score_constants::INFINITE_SCORE,
+        score_constants::INFINITE_SCORE,
+        true,
+        &table_,
+        &context_
+    );
+
+    // An infinite search that ends on its own, at the maximum depth, still waits for stop
+    if (job.infinite) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [this]() { return context_.stopped() || quit_; });
+    }
+
+    // Reports only count completed depths, so the nodes of the whole search are sent once it ends
+    send("info nodes " + std::to_string(result.nodesExplored));
+
+    // A search stopped before completing its first depth falls back to any legal move
+    auto bestMove = result.bestMove;
+    if (bestMove.move() == chess::Move::NO_MOVE) {
+        chess::Movelist legalMoves;
+        chess::movegen::legalmoves(legalMoves, root_->board());
+        if (!legalMoves.empty()) {
+            bestMove = legalMoves.front();
+        }
+    }
+    send(bestMove.move() == chess::Move::NO_MOVE ? "bestmove 0000" : "bestmove " + chess::uci::moveToUci(bestMove));
+}
+
+void
+UciEngine::send(const std::string& line)
+{
+    std::lock_guard<std::mutex> lock(outputMutex_);
+    out_ << line << std::endl;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file Uci.hpp
+ */
+
+#ifndef UCI_HPP
+#define UCI_HPP
+
+#include "AlphaBeta.hpp"
+#include "GameNode.hpp"
+#include "SearchContext.hpp"
+#include "TranspositionTable.hpp"
+#include <chess.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace uci_constants {
+    // Identification sent in reply to the uci command
+    constexpr auto ENGINE_NAME = "parallel-chess-agent";
+    constexpr auto ENGINE_AUTHOR = "the parallel-chess-agent developers";
+
+    // Number of moves that the remaining clock time is divided over when the GUI does not say
+    constexpr int DEFAULT_MOVES_TO_GO = 30;
+
+    // Time in milliseconds kept in reserve for communication with the GUI on every move
+    constexpr int MOVE_OVERHEAD_MS = 20;
+
+    // Bounds of the Hash option in megabytes
+    constexpr int MAX_HASH_MB = 65536;
+
+    // Upper bound of the Threads option
+    constexpr int MAX_THREADS = 1024;
+} // namespace uci_constants
+
+/**
+ * @class UciEngine
+ * @brief Front end that speaks the Universal Chess Interface over a pair of streams. Commands are read
+ * on the calling thread, while searches run on a single search thread that lives as long as the engine,
+ * so that the OpenMP team it forks for LazySMPTag searches is created once and reused by every later
+ * search. The transposition table is likewise kept between searches and only reallocated when the Hash
+ * option changes. Scores are reported in centipawns relative to the side to move.
+ */
+class UciEngine
+{
+    public:
+        // Delete copy constructor and assignment operator
+        UciEngine(const UciEngine&) = delete;
+        UciEngine& operator=(const UciEngine&) = delete;
+
+        /**
+         * @brief Constructor. Starts the search thread, which waits for the first go command.
+         *
+         * @param in Stream of commands from the GUI.
+         * @param out Stream of responses to the GUI.
+         */
+        UciEngine(std::istream& in, std::ostream& out);
+
+        /**
+         * @brief Destructor. Stops any running search and joins the search thread.
+         */
+        ~UciEngine();
+
+        /**
+         * @brief Process commands until quit or the end of the input. At the end of the input a running
+         * search is completed rather than stopped, so that a scripted session still gets its bestmove,
+         * except for an infinite search, which no later stop command could end.
+         */
+        void run();
+
+    private:
+        // Parameters of a go command
+        struct SearchJob
+        {
+            std::uint8_t depth;
+
+            // Whether the bestmove is held back until the GUI sends stop, as go infinite requires
+            bool infinite;
+        };
+
+        /**
+         * @brief Execute a single command line.
+         *
+         * @return Whether the engine should keep reading commands.
+         */
+        bool execute(const std::string& line);
+
+        void uci();
+        void setOption(std::istringstream& tokens);
+        void position(std::istringstream& tokens);
+        void go(std::istringstream& tokens);
+
+        /**
+         * @brief Block until the running search, if any, has sent its bestmove.
+         */
+        void waitForSearch();
+
+        /**
+         * @brief Stop the running search, if any, and release an infinite search waiting for the stop.
+         */
+        void stopSearch();
+
+        /**
+         * @brief Body of the search thread: wait for a job, search, report, repeat until quit.
+         */
+        void searchLoop();
+
+        /**
+         * @brief Search the current position and send the bestmove.
+         */
+        void search(const SearchJob& job);
+
+        /**
+         * @brief Write a line to the GUI. Lines from the command and search threads are never interleaved.
+         */
+        void send(const std::string& line);
+
+        std::istream& in_;
+        std::ostream& out_;
+        std::mutex outputMutex_;
+        std::unique_ptr<GameNode> root_;
+        TranspositionTable table_;
+        int numThreads_;
+        SearchContext context_;
+
+        std::thread searchThread_;
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::condition_variable idle_;
+        SearchJob job_;
+        bool searching_;
+        bool quit_;
+}; // class UciEngine
+
+#endif // UCI_HPP
@@ -3,17 +3,27 @@
 # Define test parameters
 BOARD_POS=${1:-0} # 0: early game, 1: end game
 DEPTH=${2:-5}
-echo "Using board position ${BOARD_POS} and depth ${DEPTH}..."
+NUMA=${3:-off} # off, shared, partitioned or replicated
+echo "Using board position ${BOARD_POS}, depth ${DEPTH} and NUMA mode ${NUMA}..."
+
+# NUMA modes pin threads to cores in order, filling one node before the next, and place tables as given
+SUFFIX=""
+if [ "${NUMA}" != "off" ]; then
+    export OMP_PLACES=cores
+    export OMP_PROC_BIND=close
+    export NUMA_TABLES=${NUMA}
+    SUFFIX="_numa_${NUMA}"
+fi
 
 # Execute test
 cd "$(dirname "$0")"
 BIN=../../bin
 SRC=../../src
-FILE="${SRC}/data/timing_results_${BOARD_POS}_${DEPTH}.csv"
+FILE="${SRC}/data/timing_results_${BOARD_POS}_${DEPTH}${SUFFIX}.csv"
 CMD="${BIN}/TimingTests ${BOARD_POS} ${DEPTH}"
 
 > $FILE
-echo "num_threads,trial,time_shared,num_nodes_shared,correct_shared,time_local,num_nodes_local,correct_local,time_blended,num_nodes_blended,correct_local,pos_idx" | tee $FILE
+echo "num_threads,trial,time_shared,num_nodes_shared,correct_shared,time_local,num_nodes_local,correct_local,time_blended,num_nodes_blended,correct_blended,pos_idx" | tee $FILE
 for num_threads in $(seq 1 32);
 do
     export OMP_NUM_THREADS=$num_threads
@@ -4,17 +4,36 @@
  */
 
 #include "../AlphaBeta.hpp"
+#include "../Analysis.hpp"
+#include "../Numa.hpp"
+#include "../Perft.hpp"
+#include "../Ponder.hpp"
+#include "../Search.hpp"
+#include "../SearchStats.hpp"
+#include "../Uci.hpp"
 #include <chess.hpp>
+#include <omp.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
 /**
  * @brief Executes unit tests to validate correctness of minimax algorithm.
  * 
+ * @param policy Search policy under test.
  * @return Number of failures.
  */
 template<typename Tag>
-int testCorrectness()
+int testCorrectness(Tag policy = Tag{})
 {
     int numTests(0), failures(0);
     std::cout << "Testing checkmate in one..." << std::endl;
@@ -31,7 +50,7 @@ int testCorrectness()
         */
         constexpr auto startPos = "1k6/6R1/1K6/8/8/8/8/8 w - - 0 1";
         auto root = std::make_unique<GameNode>(startPos);
-        auto result = alphaBeta(Tag{}, *root, 1);
+        auto result = alphaBeta(policy, *root, 1);
         auto selectedMove = result.bestMove;
         // White to move: Rook to g8
         auto bestMove = chess::Move::make(chess::Square("g7"), chess::Square("g8"));
@@ -57,7 +76,7 @@ int testCorrectness()
         */
         constexpr auto startPos = "8/8/8/8/8/1k6/6r1/1K6 b - - 0 1";
         auto root = std::make_unique<GameNode>(startPos);
-        auto result = alphaBeta(Tag{}, *root, 1);
+        auto result = alphaBeta(policy, *root, 1);
         auto selectedMove = result.bestMove;
         // Black to move: Rook to g1
         auto bestMove = chess::Move::make(chess::Square("g2"), chess::Square("g1"));
@@ -83,7 +102,7 @@ int testCorrectness()
         */
         constexpr auto startPos = "1Bb3BN/R2Pk2r/1Q5B/4q2R/2bN4/4Q1BK/1p6/1bq1R1rb w - - 0 1";
         auto root = std::make_unique<GameNode>(startPos);
-        auto result = alphaBeta(Tag{}, *root, 1);
+        auto result = alphaBeta(policy, *root, 1);
         auto selectedMove = result.bestMove;
         // White to move: Queen to a3
         auto bestMove = chess::Move::make(chess::Square("e3"), chess::Square("a3"));
@@ -111,7 +130,7 @@ int testCorrectness()
         */
         constexpr auto startPos = "5Q2/p1r5/6K1/R7/6k1/P7/8/8 w - - 0 1";
         auto root = std::make_unique<GameNode>(startPos);
-        auto result = alphaBeta(Tag{}, *root, 3);
+        auto result = alphaBeta(policy, *root, 3);
         auto selectedMove = result.bestMove;
         // White to move: Rook to g5
         auto bestMove = chess::Move::make(chess::Square("a5"), chess::Square("g5"));
@@ -125,11 +144,11 @@ int testCorrectness()
         }
         ++numTests;
         root->makeMove(selectedMove);
-        result = alphaBeta(Tag{}, *root, 2);
+        result = alphaBeta(policy, *root, 2);
         selectedMove = result.bestMove;
         // Black to move: Anywhere
         root->makeMove(selectedMove);
-        result = alphaBeta(Tag{}, *root, 1);
+        result = alphaBeta(policy, *root, 1);
         selectedMove = result.bestMove;
         // White to move: Queen to h6
         bestMove = chess::Move::make(chess::Square("f8"), chess::Square("h6"));
@@ -151,16 +170,1280 @@ int testCorrectness()
     return failures;
 }
 
+/**
+ * @brief Executes unit tests to validate that a transposition table does not change search results.
+ * 
+ * @return Number of failures.
+ */
+template<typename Tag>
+int testTranspositionTable(std::int16_t maxScore)
+{
+    int numTests(0), failures(0);
+    std::cout << "Testing root score with transposition table..." << std::endl;
+    const std::vector<std::string> startPos = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "4B3/K1N1r3/1P3B2/6P1/P7/2R5/3k4/8 w - - 0 1",
+        "5Q2/p1r5/6K1/R7/6k1/P7/8/8 w - - 0 1"
+    };
+    TranspositionTable table(1);
+    for (const auto& fen : startPos) {
+        auto root = std::make_unique<GameNode>(fen);
+        auto expected = alphaBeta(Tag{}, *root, 4);
+        table.newSearch();
+        auto result = alphaBeta(Tag{}, *root, 4, -maxScore, maxScore, true, &table);
+        // Searching the same position again should be answered by the table
+        auto repeated = alphaBeta(Tag{}, *root, 4, -maxScore, maxScore, true, &table);
+        if (result.bestMove.score() == expected.bestMove.score()
+            && repeated.bestMove.score() == expected.bestMove.score()
+            && repeated.nodesExplored <= result.nodesExplored) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Expected: " << expected.bestMove.score() << ". Got " << result.bestMove.score()
+                      << " then " << repeated.bestMove.score() << std::endl;
+            std::cout << root->board() << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    std::cout << "Testing table is bound to the score scale of its searches..." << std::endl;
+    {
+        // Searches of the game tree and of a board with make and unmake score on different scales
+        constexpr bool isWorker = std::is_same_v<Tag, MakeUnmakeTag> || std::is_same_v<Tag, LazySMPTag>;
+        using OtherTag = std::conditional_t<isWorker, SequentialTag, MakeUnmakeTag>;
+        const auto otherMaxScore = isWorker ? eval_constants::MAX_SCORE : score_constants::INFINITE_SCORE;
+        auto root = std::make_unique<GameNode>();
+        alphaBeta(Tag{}, *root, 2, -maxScore, maxScore, true, &table);
+        const bool isBound = table.scale() == (isWorker ? ScoreScale::CENTIPAWNS : ScoreScale::MATERIAL);
+        bool isRejected = false;
+        try {
+            alphaBeta(OtherTag{}, *root, 2, -otherMaxScore, otherMaxScore, true, &table);
+        } catch (const std::logic_error&) {
+            isRejected = true;
+        }
+        table.clear();
+        alphaBeta(OtherTag{}, *root, 2, -otherMaxScore, otherMaxScore, true, &table);
+        if (isBound && isRejected && table.scale() != (isWorker ? ScoreScale::CENTIPAWNS : ScoreScale::MATERIAL)) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << (isBound ? "" : "Not bound. ") << (isRejected ? "" : "Not rejected.") << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    if (failures) {
+        std::cout << "FAILED: " << failures << "/" << numTests << " TESTS FAILED." << std::endl;
+    } else {
+        std::cout << "SUCCESS: " << numTests << "/" << numTests << " TESTS PASSED." << std::endl;
+    }
+    return failures;
+}
+
+/**
+ * @brief Executes unit tests to validate the iterative deepening driver and its search budget.
+ * 
+ * @return Number of failures.
+ */
+int testIterativeDeepening()
+{
+    int numTests(0), failures(0);
+    std::cout << "Testing checkmate in two with iterative deepening..." << std::endl;
+    {
+        constexpr auto startPos = "5Q2/p1r5/6K1/R7/6k1/P7/8/8 w - - 0 1";
+        auto root = std::make_unique<GameNode>(startPos);
+        SearchLimits limits;
+        limits.depth = 5;
+        TranspositionTable table(1);
+        auto selectedMove = iterativeDeepening(*root, limits, &table).bestMove;
+        // White to move: Rook to g5
+        auto bestMove = chess::Move::make(chess::Square("a5"), chess::Square("g5"));
+        if (selectedMove == bestMove) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Expected: " << bestMove << ". Got " << selectedMove << std::endl;
+            std::cout << root->board() << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    std::cout << "Testing deepening stops once a mate is within the completed depth..." << std::endl;
+    {
+        constexpr auto startPos = "5Q2/p1r5/6K1/R7/6k1/P7/8/8 w - - 0 1";
+        auto root = std::make_unique<GameNode>(startPos);
+        SearchLimits limits;
+        limits.depth = 8;
+        SearchContext context;
+        std::vector<SearchProgress> reports;
+        context.setCallback([&reports](const SearchProgress& progress) { reports.push_back(progress); });
+        auto result = iterativeDeepening(*root, limits, nullptr, &context);
+
+        // Mate in two moves is three plies away, so the third iteration proves that it is the shortest
+        constexpr int mateDistance = 3;
+        if (!reports.empty() && reports.back().depth == mateDistance
+            && result.bestMove.score() == score_constants::MATE_SCORE - mateDistance) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Got score " << result.bestMove.score() << " after " << reports.size() << " reports" << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    std::cout << "Testing time and node budgets..." << std::endl;
+    {
+        auto root = std::make_unique<GameNode>();
+        chess::Movelist legalMoves;
+        chess::movegen::legalmoves(legalMoves, root->board());
+
+        SearchLimits limits;
+        limits.moveTime = std::chrono::milliseconds(50);
+        auto start = std::chrono::steady_clock::now();
+        auto result = iterativeDeepening(*root, limits);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        // Allow generous slack for loaded machines, the budget only has to bound the search
+        bool withinTime = elapsed < std::chrono::milliseconds(500);
+        bool isLegal = std::find(legalMoves.begin(), legalMoves.end(), result.bestMove) != legalMoves.end();
+        if (withinTime && isLegal) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Got " << result.bestMove << " after "
+                      << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << " ms" << std::endl;
+            ++failures;
+        }
+        ++numTests;
+
+        limits = SearchLimits();
+        limits.nodes = 10000;
+        result = iterativeDeepening(*root, limits);
+        isLegal = std::find(legalMoves.begin(), legalMoves.end(), result.bestMove) != legalMoves.end();
+        // The budget is polled periodically, so the search may overshoot it slightly
+        if (isLegal && result.nodesExplored < 2 * limits.nodes) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Got " << result.bestMove << " after " << result.nodesExplored << " nodes" << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    std::cout << "Testing iteration reports..." << std::endl;
+    {
+        auto root = std::make_unique<GameNode>();
+        SearchLimits limits;
+        limits.depth = 4;
+        SearchContext context;
+        std::vector<SearchProgress> reports;
+        context.setCallback([&reports](const SearchProgress& progress) { reports.push_back(progress); });
+        auto result = iterativeDeepening(*root, limits, nullptr, &context);
+
+        bool isOrdered = reports.size() == limits.depth;
+        for (size_t i = 0; i < reports.size() && isOrdered; ++i) {
+            isOrdered = reports[i].depth == static_cast<int>(i + 1);
+        }
+        if (isOrdered && reports.back().bestMove == result.bestMove && reports.back().nodes == result.nodesExplored) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Got " << reports.size() << " reports for " << result.bestMove << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    if (failures) {
+        std::cout << "FAILED: " << failures << "/" << numTests << " TESTS FAILED." << std::endl;
+    } else {
+        std::cout << "SUCCESS: " << numTests << "/" << numTests << " TESTS PASSED." << std::endl;
+    }
+    return failures;
+}
+
+/**
+ * @brief Executes unit tests to validate that null-window scouting and aspiration windows find the
+ * same root score as a search with the full window.
+ *
+ * @return Number of failures.
+ */
+int testPrincipalVariation()
+{
+    int numTests(0), failures(0);
+    std::cout << "Testing root score with null windows..." << std::endl;
+    const std::vector<std::string> startPos = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r1bqkbnr/pppp1ppp/2n5/4p3/3PP3/5N2/PPP2PPP/RNBQKB1R b KQkq - 0 1",
+        "4B3/K1N1r3/1P3B2/6P1/P7/2R5/3k4/8 w - - 0 1"
+    };
+    for (const auto& fen : startPos) {
+        auto root = std::make_unique<GameNode>(fen);
+        auto expected = alphaBeta(SequentialTag{}, *root, 4);
+        auto result = alphaBeta(PVSTag{}, *root, 4);
+        // Iterative deepening uses aspiration windows from the fourth iteration on
+        SearchLimits limits;
+        limits.depth = 5;
+        auto expectedDeepening = alphaBeta(MakeUnmakeTag{}, *root, 5);
+        auto resultDeepening = iterativeDeepening(*root, limits);
+        if (result.bestMove.score() == expected.bestMove.score()
+            && resultDeepening.bestMove.score() == expectedDeepening.bestMove.score()) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Expected: " << expected.bestMove.score() << " and " << expectedDeepening.bestMove.score()
+                      << ". Got " << result.bestMove.score() << " and " << resultDeepening.bestMove.score() << std::endl;
+            std::cout << root->board() << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    if (failures) {
+        std::cout << "FAILED: " << failures << "/" << numTests << " TESTS FAILED." << std::endl;
+    } else {
+        std::cout << "SUCCESS: " << numTests << "/" << numTests << " TESTS PASSED." << std::endl;
+    }
+    return failures;
+}
+
+/**
+ * @brief Executes unit tests to validate that captures are resolved at the search horizon.
+ *
+ * @return Number of failures.
+ */
+template<typename Tag>
+int testQuiescence()
+{
+    int numTests(0), failures(0);
+
+    // Game tree policies only resolve captures at the horizon when asked to
+    Tag policy;
+    constexpr bool isTreePolicy = !std::is_same_v<Tag, MakeUnmakeTag> && !std::is_same_v<Tag, LazySMPTag>;
+    if constexpr (isTreePolicy) {
+        policy.resolveCaptures = true;
+    }
+    std::cout << "Testing defended pawn at the horizon..." << std::endl;
+    {
+        /*
+        . . . . k . . .
+        . . . . . . . .
+        . . . . p . . .
+        . . . p . . . .
+        . . . . . . . .
+        . . . . . . . .
+        . . . . . . . .
+        . . . Q K . . .
+        */
+        constexpr auto startPos = "4k3/8/4p3/3p4/8/8/8/3QK3 w - - 0 1";
+        auto root = std::make_unique<GameNode>(startPos);
+        auto result = alphaBeta(policy, *root, 1);
+        auto selectedMove = result.bestMove;
+        // White to move: anything but capturing the pawn, which loses the queen
+        auto losingMove = chess::Move::make(chess::Square("d1"), chess::Square("d5"));
+        if (selectedMove != losingMove) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Got " << selectedMove << std::endl;
+            std::cout << root->board() << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    if constexpr (isTreePolicy) {
+        std::cout << "Testing static evaluation at the horizon by default..." << std::endl;
+        constexpr auto startPos = "4k3/8/4p3/3p4/8/8/8/3QK3 w - - 0 1";
+        auto root = std::make_unique<GameNode>(startPos);
+        auto result = alphaBeta(Tag{}, *root, 1);
+        auto selectedMove = result.bestMove;
+        // White to move: the static evaluation only sees the pawn won at the horizon
+        auto greedyMove = chess::Move::make(chess::Square("d1"), chess::Square("d5"));
+        if (selectedMove == greedyMove && result.nodesExplored == root->children().size()) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Got " << selectedMove << " after " << result.nodesExplored << " nodes" << std::endl;
+            std::cout << root->board() << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    if (failures) {
+        std::cout << "FAILED: " << failures << "/" << numTests << " TESTS FAILED." << std::endl;
+    } else {
+        std::cout << "SUCCESS: " << numTests << "/" << numTests << " TESTS PASSED." << std::endl;
+    }
+    return failures;
+}
+
+/**
+ * @brief Executes unit tests to validate that the incremental evaluation matches one computed from
+ * scratch after castling, en passant, captures and promotions are made and unmade.
+ *
+ * @return Number of failures.
+ */
+int testEvaluation()
+{
+    int numTests(0), failures(0);
+    // Positions where every special move is legal, paired with the move to make in each
+    const std::vector<std::pair<std::string, std::string>> positions = {
+        {"r3k2r/pppq1ppp/2n2n2/3pp3/1bPPP3/2N2N2/PP1Q1PPP/R3K2R w KQkq - 0 1", "e1g1"},
+        {"r3k2r/pppq1ppp/2n2n2/3pp3/1bPPP3/2N2N2/PP1Q1PPP/R3K2R b KQkq - 0 1", "e8c8"},
+        {"4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1", "e5d6"},
+        {"4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1", "e5e6"},
+        {"1r2k3/P7/8/8/8/8/8/4K3 w - - 0 1", "a7b8q"},
+        {"1r2k3/P7/8/8/8/8/8/4K3 w - - 0 1", "a7a8n"},
+        {"r1bqkbnr/pppp1ppp/2n5/4p3/3PP3/5N2/PPP2PPP/RNBQKB1R b KQkq - 0 1", "e5d4"},
+    };
+    for (const auto& [fen, uci] : positions) {
+        std::cout << "Testing incremental evaluation of " << uci << "..." << std::endl;
+        chess::Board board(fen);
+        Evaluator evaluator(board);
+        auto before = evaluator.evaluate(board);
+        auto move = chess::uci::uciToMove(board, uci);
+        evaluator.makeMove(board, move);
+        board.makeMove(move);
+        auto incremental = evaluator.evaluate(board);
+        auto expected = Evaluator(board).evaluate(board);
+        board.unmakeMove(move);
+        evaluator.unmakeMove();
+        auto restored = evaluator.evaluate(board);
+        if (incremental == expected && restored == before) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Expected: " << expected << ". Got " << incremental
+                      << " (" << restored << " after unmaking, " << before << " before)" << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    if (failures) {
+        std::cout << "FAILED: " << failures << "/" << numTests << " TESTS FAILED." << std::endl;
+    } else {
+        std::cout << "SUCCESS: " << numTests << "/" << numTests << " TESTS PASSED." << std::endl;
+    }
+    return failures;
+}
+
+/**
+ * @brief Executes unit tests to validate that game trees release their arena memory for reuse.
+ *
+ * @return Number of failures.
+ */
+int testNodeArena()
+{
+    int numTests(0), failures(0);
+    std::cout << "Testing arena reuse after tree teardown..." << std::endl;
+    {
+        auto& arena = NodeArena::local();
+        size_t reserved = 0;
+        bool reused = true;
+        for (int i = 0; i < 3; ++i) {
+            {
+                GameNode root("r1bqkbnr/pppp1ppp/2n5/4p3/3PP3/5N2/PPP2PPP/RNBQKB1R b KQkq - 0 1");
+                alphaBeta(SequentialTag{}, root, 3);
+            }
+            // Every search builds the same tree, so after the first the arena should not grow
+            reused = reused && arena.liveAllocations() == 0 && (i == 0 || arena.bytesReserved() == reserved);
+            reserved = arena.bytesReserved();
+        }
+        if (reused && reserved > 0) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Got " << arena.liveAllocations() << " live allocations in " << reserved << " bytes" << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    std::cout << "Testing arena memory stays bounded across promotions..." << std::endl;
+    {
+        // Each search expands new nodes below the promoted subtree, which would otherwise keep every
+        // earlier tree alive in the arenas for the rest of the game. The game is played on a new thread
+        // so that its arenas hold nothing else.
+        size_t firstReserved = 0, maxReserved = 0;
+        std::thread game([&firstReserved, &maxReserved]() {
+            auto reservedBytes = []() { return NodeArena::local().bytesReserved() + NodeArena::spare().bytesReserved(); };
+            auto root = std::make_unique<GameNode>();
+            for (int ply = 0; ply < 12; ++ply) {
+                auto played = alphaBeta(SequentialTag{}, *root, 3, eval_constants::MIN_SCORE, eval_constants::MAX_SCORE, ply % 2 == 0).bestMove;
+                root->promote(played);
+                maxReserved = std::max(maxReserved, reservedBytes());
+                if (ply == 1) {
+                    firstReserved = reservedBytes();
+                }
+            }
+        });
+        game.join();
+        if (maxReserved <= 2 * firstReserved) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Grew from " << firstReserved << " to " << maxReserved << " bytes" << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    if (failures) {
+        std::cout << "FAILED: " << failures << "/" << numTests << " TESTS FAILED." << std::endl;
+    } else {
+        std::cout << "SUCCESS: " << numTests << "/" << numTests << " TESTS PASSED." << std::endl;
+    }
+    return failures;
+}
+
+/**
+ * @brief Executes unit tests to validate searches over a compact tree kept between searches.
+ *
+ * @return Number of failures.
+ */
+int testCompactTree()
+{
+    int numTests(0), failures(0);
+    std::cout << "Testing compact tree reuse..." << std::endl;
+    {
+        constexpr auto startPos = "r1bqkbnr/pppp1ppp/2n5/4p3/3PP3/5N2/PPP2PPP/RNBQKB1R b KQkq - 0 1";
+        auto root = std::make_unique<GameNode>(startPos);
+        auto expected = alphaBeta(SequentialTag{}, *root, 4);
+        CompactTree tree(startPos);
+        auto result = alphaBeta(CompactTreeTag{}, tree, 4);
+        auto size = tree.size();
+        // Searching the same tree again should find every node already expanded
+        auto repeated = alphaBeta(CompactTreeTag{}, tree, 4);
+        if (result.bestMove.score() == expected.bestMove.score()
+            && repeated.bestMove.score() == expected.bestMove.score()
+            && tree.size() == size
+            && tree.score(CompactTree::root()) == expected.bestMove.score()
+            && tree.memoryUsage() <= 16 * tree.size()) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Expected: " << expected.bestMove.score() << ". Got " << result.bestMove.score()
+                      << " then " << repeated.bestMove.score() << " with " << size << " then " << tree.size()
+                      << " nodes in " << tree.memoryUsage() << " bytes" << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    std::cout << "Testing compact tree horizon nodes are not expanded..." << std::endl;
+    {
+        // A depth-1 search expands the root only, so the tree holds the root and its 20 children
+        CompactTree tree;
+        alphaBeta(CompactTreeTag{}, tree, 1);
+        if (tree.size() == 21) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Expected: 21 nodes. Got " << tree.size() << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    if (failures) {
+        std::cout << "FAILED: " << failures << "/" << numTests << " TESTS FAILED." << std::endl;
+    } else {
+        std::cout << "SUCCESS: " << numTests << "/" << numTests << " TESTS PASSED." << std::endl;
+    }
+    return failures;
+}
+
+/**
+ * @brief Executes unit tests to validate that trees promoted to a played move search like new ones.
+ *
+ * @return Number of failures.
+ */
+int testTreeReuse()
+{
+    int numTests(0), failures(0);
+    std::cout << "Testing subtree promotion..." << std::endl;
+    {
+        constexpr auto startPos = "r1bqkbnr/pppp1ppp/2n5/4p3/3PP3/5N2/PPP2PPP/RNBQKB1R b KQkq - 0 1";
+        auto root = std::make_unique<GameNode>(startPos);
+        CompactTree tree(startPos);
+        auto played = alphaBeta(SequentialTag{}, *root, 4).bestMove;
+        alphaBeta(CompactTreeTag{}, tree, 4);
+        auto size = tree.size();
+
+        // Both the played move and the reply searched first should already be expanded
+        bool promoted = root->promote(played) && tree.promote(played);
+        auto reply = root->children().front().lastMove();
+        promoted = promoted && root->promote(reply) && tree.promote(reply);
+
+        chess::Board board(startPos);
+        board.makeMove(played);
+        board.makeMove(reply);
+        auto fresh = std::make_unique<GameNode>(board.getFen());
+        auto expected = alphaBeta(SequentialTag{}, *fresh, 2, eval_constants::MIN_SCORE, eval_constants::MAX_SCORE, false);
+        auto result = alphaBeta(SequentialTag{}, *root, 2, eval_constants::MIN_SCORE, eval_constants::MAX_SCORE, false);
+        auto compactResult = alphaBeta(CompactTreeTag{}, tree, 2, eval_constants::MIN_SCORE, eval_constants::MAX_SCORE, false);
+        if (promoted
+            && root->board().hash() == board.hash()
+            && tree.rootBoard().hash() == board.hash()
+            && tree.size() < size
+            && result.bestMove.score() == expected.bestMove.score()
+            && compactResult.bestMove.score() == expected.bestMove.score()) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Expected: " << expected.bestMove.score() << ". Got " << result.bestMove.score()
+                      << " and " << compactResult.bestMove.score() << (promoted ? "" : " without promotion") << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    if (failures) {
+        std::cout << "FAILED: " << failures << "/" << numTests << " TESTS FAILED." << std::endl;
+    } else {
+        std::cout << "SUCCESS: " << numTests << "/" << numTests << " TESTS PASSED." << std::endl;
+    }
+    return failures;
+}
+
+/**
+ * @brief Executes unit tests to validate that background searches can be converted or discarded.
+ *
+ * @return Number of failures.
+ */
+int testPondering()
+{
+    int numTests(0), failures(0);
+    auto root = std::make_unique<GameNode>();
+    auto played = chess::Move::make(chess::Square("e2"), chess::Square("e4"));
+    root->makeMove(played);
+    auto reply = chess::Move::make(chess::Square("e7"), chess::Square("e5"));
+    TranspositionTable table(4);
+    Ponderer ponderer(&table);
+
+    std::cout << "Testing ponderhit..." << std::endl;
+    {
+        ponderer.start(*root, reply);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        SearchLimits limits;
+        limits.moveTime = std::chrono::milliseconds(30);
+        auto start = std::chrono::steady_clock::now();
+        auto result = ponderer.ponderhit(limits);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        chess::Movelist legalMoves;
+        chess::movegen::legalmoves(legalMoves, ponderer.position().board());
+        bool isLegal = std::find(legalMoves.begin(), legalMoves.end(), result.bestMove) != legalMoves.end();
+        if (isLegal && !ponderer.isPondering() && elapsed < std::chrono::milliseconds(500)) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Got " << result.bestMove << " after "
+                      << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << " ms" << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    std::cout << "Testing ponderhit with depth and node budgets..." << std::endl;
+    for (const auto& [depth, nodes] : {std::make_tuple(3, 0), std::make_tuple(static_cast<int>(search_constants::MAX_DEPTH), 20000)}) {
+        ponderer.start(*root, reply);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        SearchLimits limits;
+        limits.depth = depth;
+        limits.nodes = nodes;
+        auto start = std::chrono::steady_clock::now();
+        auto result = ponderer.ponderhit(limits);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        chess::Movelist legalMoves;
+        chess::movegen::legalmoves(legalMoves, ponderer.position().board());
+        bool isLegal = std::find(legalMoves.begin(), legalMoves.end(), result.bestMove) != legalMoves.end();
+        if (isLegal && !ponderer.isPondering() && elapsed < std::chrono::milliseconds(1000)) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Got " << result.bestMove << " after "
+                      << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << " ms" << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    std::cout << "Testing ponder stop..." << std::endl;
+    {
+        ponderer.start(*root, reply);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        auto start = std::chrono::steady_clock::now();
+        ponderer.stop();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        if (!ponderer.isPondering() && elapsed < std::chrono::milliseconds(500)) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Stopped after " << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << " ms" << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    if (failures) {
+        std::cout << "FAILED: " << failures << "/" << numTests << " TESTS FAILED." << std::endl;
+    } else {
+        std::cout << "SUCCESS: " << numTests << "/" << numTests << " TESTS PASSED." << std::endl;
+    }
+    return failures;
+}
+
+/**
+ * @brief Executes unit tests to validate that searches can be cancelled and report their progress.
+ *
+ * @param deepDepth Depth at which a search from the starting position takes far longer than the tests.
+ *
+ * @return Number of failures.
+ */
+template<typename Tag>
+int testSearchContext(std::uint8_t deepDepth)
+{
+    int numTests(0), failures(0);
+    auto root = std::make_unique<GameNode>();
+    chess::Movelist legalMoves;
+    chess::movegen::legalmoves(legalMoves, root->board());
+
+    std::cout << "Testing stop from another thread..." << std::endl;
+    {
+        SearchContext context;
+        std::thread stopper([&context]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(30));
+            context.stop();
+        });
+        auto start = std::chrono::steady_clock::now();
+        alphaBeta(Tag{}, *root, deepDepth, -score_constants::INFINITE_SCORE, score_constants::INFINITE_SCORE, true, nullptr, &context);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        stopper.join();
+        if (context.stopped() && elapsed < std::chrono::milliseconds(1000)) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Returned after " << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << " ms" << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    std::cout << "Testing time limit..." << std::endl;
+    {
+        SearchContext context;
+        context.setMoveTime(std::chrono::milliseconds(30));
+        auto start = std::chrono::steady_clock::now();
+        auto result = alphaBeta(Tag{}, *root, deepDepth, -score_constants::INFINITE_SCORE, score_constants::INFINITE_SCORE, true, nullptr, &context);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        // Parallel iterative searches return the deepest depth completed before the limit
+        bool isLegal = std::find(legalMoves.begin(), legalMoves.end(), result.bestMove) != legalMoves.end();
+        if (context.stopped() && elapsed < std::chrono::milliseconds(1000) && (isLegal || !std::is_same_v<Tag, LazySMPTag>)) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Returned after " << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << " ms" << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    std::cout << "Testing node limit shared by all threads..." << std::endl;
+    {
+        const int maxThreads = omp_get_max_threads();
+        omp_set_num_threads(4);
+        SearchContext context;
+        context.setNodeLimit(20000);
+        auto result = alphaBeta(Tag{}, *root, deepDepth, -score_constants::INFINITE_SCORE, score_constants::INFINITE_SCORE, true, nullptr, &context);
+        omp_set_num_threads(maxThreads);
+
+        // Threads add their nodes to the shared count in batches, so the limit may be overshot slightly
+        bool isLegal = std::find(legalMoves.begin(), legalMoves.end(), result.bestMove) != legalMoves.end();
+        if (context.stopped() && result.nodesExplored < 2 * context.nodeLimit() && (isLegal || !std::is_same_v<Tag, LazySMPTag>)) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Got " << result.bestMove << " after " << result.nodesExplored << " nodes" << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    std::cout << "Testing progress reports..." << std::endl;
+    {
+        SearchContext context;
+        std::vector<SearchProgress> reports;
+        context.setCallback([&reports](const SearchProgress& progress) { reports.push_back(progress); });
+        constexpr std::uint8_t depth = 2;
+        auto result = alphaBeta(Tag{}, *root, depth, -score_constants::INFINITE_SCORE, score_constants::INFINITE_SCORE, true, nullptr, &context);
+
+        // Parallel iterative searches report each depth, and searches of the game tree also report
+        // every searched root move before their completion
+        bool isOrdered = !reports.empty();
+        for (size_t i = 1; i < reports.size() && isOrdered; ++i) {
+            isOrdered = reports[i].depth >= reports[i - 1].depth;
+        }
+        constexpr bool reportsRootMoves = !std::is_same_v<Tag, MakeUnmakeTag> && !std::is_same_v<Tag, LazySMPTag>;
+        bool isLegal = std::find(legalMoves.begin(), legalMoves.end(), result.bestMove) != legalMoves.end();
+        if (isOrdered && isLegal && !context.stopped() && reports.back().depth == depth
+            && reports.back().bestMove == result.bestMove && (!reportsRootMoves || reports.size() > static_cast<std::size_t>(legalMoves.size()))) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Got " << reports.size() << " reports for " << result.bestMove << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    std::cout << "Testing progress report of a stored root..." << std::endl;
+    {
+        TranspositionTable table(1);
+        constexpr std::uint8_t depth = 2;
+        alphaBeta(Tag{}, *root, depth, -score_constants::INFINITE_SCORE, score_constants::INFINITE_SCORE, true, &table, nullptr);
+
+        // The root is decided by the table, which must still be reported
+        SearchContext context;
+        std::vector<SearchProgress> reports;
+        context.setCallback([&reports](const SearchProgress& progress) { reports.push_back(progress); });
+        auto result = alphaBeta(Tag{}, *root, depth, -score_constants::INFINITE_SCORE, score_constants::INFINITE_SCORE, true, &table, &context);
+        if (!reports.empty() && reports.back().depth == depth && reports.back().bestMove == result.bestMove) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Got " << reports.size() << " reports for " << result.bestMove << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    if (failures) {
+        std::cout << "FAILED: " << failures << "/" << numTests << " TESTS FAILED." << std::endl;
+    } else {
+        std::cout << "SUCCESS: " << numTests << "/" << numTests << " TESTS PASSED." << std::endl;
+    }
+    return failures;
+}
+
+/**
+ * @brief Executes unit tests to validate the UCI front end over string streams.
+ *
+ * @return Number of failures.
+ */
+int testUci()
+{
+    int numTests(0), failures(0);
+    // Run a scripted session to its end, which waits for the last search to send its bestmove
+    auto runSession = [](const std::string& commands) {
+        std::istringstream in(commands);
+        std::ostringstream out;
+        UciEngine engine(in, out);
+        engine.run();
+        return out.str();
+    };
+
+    std::cout << "Testing handshake..." << std::endl;
+    {
+        auto output = runSession("uci\nsetoption name Hash value 1\nisready\n");
+        if (output.find("uciok") != std::string::npos && output.find("readyok") != std::string::npos) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << output << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    std::cout << "Testing checkmate in one..." << std::endl;
+    {
+        auto output = runSession("position fen 1k6/6R1/1K6/8/8/8/8/8 w - - 0 1\ngo depth 3\n");
+        if (output.find("bestmove g7g8") != std::string::npos && output.find("score mate 1") != std::string::npos) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << output << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    std::cout << "Testing position with moves..." << std::endl;
+    {
+        auto output = runSession("position startpos moves e2e4 e7e5 g1f3\ngo nodes 2000\n");
+        auto bestMove = output.substr(output.rfind("bestmove ") + 9, 4);
+        auto root = std::make_unique<GameNode>();
+        for (const auto& move : {"e2e4", "e7e5", "g1f3"}) {
+            root->makeMove(chess::uci::uciToMove(root->board(), move));
+        }
+        chess::Movelist legalMoves;
+        chess::movegen::legalmoves(legalMoves, root->board());
+        auto move = chess::uci::uciToMove(root->board(), bestMove);
+        if (std::find(legalMoves.begin(), legalMoves.end(), move) != legalMoves.end()) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << output << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    std::cout << "Testing node limit with several threads..." << std::endl;
+    {
+        auto output = runSession("setoption name Threads value 4\nposition startpos\ngo nodes 20000\n");
+        // The nodes of every thread are reported once the search ends, and together stay near the limit
+        size_t maxNodes = 0;
+        for (auto pos = output.find(" nodes "); pos != std::string::npos; pos = output.find(" nodes ", pos + 1)) {
+            maxNodes = std::max<size_t>(maxNodes, std::stoull(output.substr(pos + 7)));
+        }
+        if (output.find("bestmove ") != std::string::npos && maxNodes > 0 && maxNodes < 2 * 20000) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << output << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    std::cout << "Testing infinite search until stop..." << std::endl;
+    {
+        // The end of the input stops an infinite search like a stop command
+        auto stopped = runSession("position startpos\ngo infinite\nstop\n");
+        auto ended = runSession("position startpos\ngo depth 1 infinite\n");
+        auto root = std::make_unique<GameNode>();
+        chess::Movelist legalMoves;
+        chess::movegen::legalmoves(legalMoves, root->board());
+        auto isLegal = [&](const std::string& output) {
+            auto pos = output.rfind("bestmove ");
+            if (pos == std::string::npos) {
+                return false;
+            }
+            auto move = chess::uci::uciToMove(root->board(), output.substr(pos + 9, 4));
+            return std::find(legalMoves.begin(), legalMoves.end(), move) != legalMoves.end();
+        };
+        if (isLegal(stopped) && isLegal(ended)) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << stopped << ended << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    if (failures) {
+        std::cout << "FAILED: " << failures << "/" << numTests << " TESTS FAILED." << std::endl;
+    } else {
+        std::cout << "SUCCESS: " << numTests << "/" << numTests << " TESTS PASSED." << std::endl;
+    }
+    return failures;
+}
+
+/**
+ * @brief Executes unit tests to validate reading, analyzing and writing batches of positions.
+ *
+ * @return Number of failures.
+ */
+int testBatchAnalysis()
+{
+    int numTests(0), failures(0);
+    std::istringstream input(
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1\n"
+        "# comment\n"
+        "1k6/6R1/1K6/8/8/8/8/8 w - - bm Rg8; id \"mate.1\";\n"
+        "\n"
+        "4B3/K1N1r3/1P3B2/6P1/P7/2R5/3k4/8 w - - 0 1\n"
+    );
+    auto positions = readPositions(input);
+
+    std::cout << "Testing FEN and EPD input..." << std::endl;
+    {
+        if (positions.size() == 3 && positions[1].id == "mate.1" && positions[1].fen == "1k6/6R1/1K6/8/8/8/8/8 w - - 0 1") {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Read " << positions.size() << " positions" << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    std::cout << "Testing analysis order and results..." << std::endl;
+    {
+        AnalysisOptions options;
+        options.depth = 3;
+        for (bool parallelTail : {false, true}) {
+            options.parallelTail = parallelTail;
+            auto records = analyzePositions(positions, options);
+            bool isOrdered = records.size() == positions.size();
+            for (size_t i = 0; i < records.size() && isOrdered; ++i) {
+                isOrdered = records[i].index == i && records[i].position.fen == positions[i].fen;
+            }
+            auto bestMove = chess::Move::make(chess::Square("g7"), chess::Square("g8"));
+            if (isOrdered && records[1].bestMove == bestMove) {
+                std::cout << "----- PASSED -----" << std::endl;
+            } else {
+                std::cout << "----- FAILED -----" << std::endl;
+                std::cout << "Got " << records.size() << " records" << std::endl;
+                ++failures;
+            }
+            ++numTests;
+        }
+    }
+    std::cout << "Testing CSV and JSON output..." << std::endl;
+    {
+        AnalysisOptions options;
+        options.depth = 1;
+        auto records = analyzePositions(positions, options);
+        std::ostringstream csv, json;
+        writeRecords(csv, records, OutputFormat::CSV);
+        writeRecords(json, records, OutputFormat::JSON);
+        auto table = csv.str();
+        auto text = json.str();
+        if (std::count(table.begin(), table.end(), '\n') == 4 && text.front() == '[' && text.find("\"id\": \"mate.1\"") != std::string::npos) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << table << text << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    if (failures) {
+        std::cout << "FAILED: " << failures << "/" << numTests << " TESTS FAILED." << std::endl;
+    } else {
+        std::cout << "SUCCESS: " << numTests << "/" << numTests << " TESTS PASSED." << std::endl;
+    }
+    return failures;
+}
+
+/**
+ * @brief Executes unit tests to validate tree construction and move generation against the node
+ * counts of the perft suite.
+ *
+ * @return Number of failures.
+ */
+int testPerft()
+{
+    int numTests(0), failures(0);
+    constexpr int depth = 3;
+    for (const auto& position : perftSuite()) {
+        std::cout << "Testing perft of " << position.name << "..." << std::endl;
+        GameNode root(position.fen);
+        chess::Board board = root.board();
+        PerftTable table(1);
+        const std::vector<std::uint64_t> counts = {
+            perft(root, depth),
+            perftParallel(root, depth),
+            perft(board, depth),
+            perft(board, depth, &table),
+            perftParallel(board, depth, &table),
+        };
+        const auto expected = position.nodes[depth - 1];
+        if (std::all_of(counts.begin(), counts.end(), [expected](std::uint64_t nodes) { return nodes == expected; })
+            && board.getFen() == position.fen) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Expected: " << expected << ". Got";
+            for (auto nodes : counts) {
+                std::cout << " " << nodes;
+            }
+            std::cout << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    if (failures) {
+        std::cout << "FAILED: " << failures << "/" << numTests << " TESTS FAILED." << std::endl;
+    } else {
+        std::cout << "SUCCESS: " << numTests << "/" << numTests << " TESTS PASSED." << std::endl;
+    }
+    return failures;
+}
+
+/**
+ * @brief Executes unit tests to validate the search statistics of an execution policy: counters are
+ * consistent with each other when compiled in and all zero when compiled out, and reset clears them.
+ *
+ * @return Number of failures.
+ */
+template<typename Tag>
+int testSearchStatistics(bool isParallel)
+{
+    int numTests(0), failures(0);
+    std::cout << "Testing statistics of one search..." << std::endl;
+    resetSearchStatistics();
+    GameNode root("r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3");
+    TranspositionTable table(1);
+    constexpr std::uint8_t depth = 4;
+    alphaBeta(Tag{}, root, depth, -score_constants::INFINITE_SCORE, score_constants::INFINITE_SCORE, true, &table);
+    auto stats = searchStatistics();
+    bool passed;
+    if constexpr (stats_constants::ENABLED) {
+        const bool split = isParallel && omp_get_max_threads() > 1;
+        passed = stats.nodesPerDepth[depth] >= 1
+            && stats.nodes() > stats.interiorNodes
+            && stats.interiorNodes >= stats.cutoffs
+            && stats.cutoffs >= stats.firstMoveCutoffs
+            && stats.cutoffs > 0
+            && stats.tableProbes >= stats.tableHits
+            && stats.tableProbes > 0
+            && (!split || (stats.splits > 0 && !stats.threads.empty() && stats.threads[0].busy.count() > 0));
+    } else {
+        passed = stats.nodes() == 0 && stats.tableProbes == 0 && stats.splits == 0 && stats.threads.empty();
+    }
+    if (passed) {
+        std::cout << "----- PASSED -----" << std::endl;
+    } else {
+        std::cout << "----- FAILED -----" << std::endl;
+        writeStatistics(std::cout, stats);
+        ++failures;
+    }
+    ++numTests;
+
+    std::cout << "Testing statistics after reset..." << std::endl;
+    resetSearchStatistics();
+    stats = searchStatistics();
+    if (stats.nodes() == 0 && stats.interiorNodes == 0 && stats.tableProbes == 0 && stats.splits == 0) {
+        std::cout << "----- PASSED -----" << std::endl;
+    } else {
+        std::cout << "----- FAILED -----" << std::endl;
+        writeStatistics(std::cout, stats);
+        ++failures;
+    }
+    ++numTests;
+
+    if (failures) {
+        std::cout << "FAILED: " << failures << "/" << numTests << " TESTS FAILED." << std::endl;
+    } else {
+        std::cout << "SUCCESS: " << numTests << "/" << numTests << " TESTS PASSED." << std::endl;
+    }
+    return failures;
+}
+
+/**
+ * @brief Executes unit tests to validate that the selective make/unmake search, with null-move pruning
+ * and late move reductions, keeps the effective branching factor low.
+ *
+ * @return Number of failures.
+ */
+int testSelectiveSearch()
+{
+    int numTests(0), failures(0);
+    std::cout << "Testing effective branching factor of the selective search..." << std::endl;
+    const std::vector<std::string> positions = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3"
+    };
+    constexpr int shallowDepth = 5, deepDepth = 8;
+    double logBranchingFactor = 0.0;
+    for (const auto& fen : positions) {
+        GameNode root(fen);
+        TranspositionTable shallowTable(4), deepTable(4);
+        auto shallow = alphaBeta(MakeUnmakeTag{}, root, shallowDepth, -score_constants::INFINITE_SCORE, score_constants::INFINITE_SCORE, true, &shallowTable);
+        auto deep = alphaBeta(MakeUnmakeTag{}, root, deepDepth, -score_constants::INFINITE_SCORE, score_constants::INFINITE_SCORE, true, &deepTable);
+        logBranchingFactor += std::log(static_cast<double>(deep.nodesExplored) / shallow.nodesExplored) / (deepDepth - shallowDepth);
+    }
+    // A full-width search of these positions grows by a factor of about 4.5 per ply
+    const double branchingFactor = std::exp(logBranchingFactor / positions.size());
+    if (branchingFactor < 3.0) {
+        std::cout << "----- PASSED -----" << std::endl;
+    } else {
+        std::cout << "----- FAILED -----" << std::endl;
+        std::cout << "Expected a branching factor below 3. Got " << branchingFactor << std::endl;
+        ++failures;
+    }
+    ++numTests;
+
+    if (failures) {
+        std::cout << "FAILED: " << failures << "/" << numTests << " TESTS FAILED." << std::endl;
+    } else {
+        std::cout << "SUCCESS: " << numTests << "/" << numTests << " TESTS PASSED." << std::endl;
+    }
+    return failures;
+}
+
+/**
+ * @brief Executes unit tests to validate that the game result decided from the first legal move found
+ * agrees with Board::isGameOver, including positions where only a pawn, knight or slider can move.
+ *
+ * @return Number of failures.
+ */
+int testGameResult()
+{
+    int numTests(0), failures(0);
+    const std::vector<std::tuple<std::string, std::string, chess::GameResult, bool>> positions = {
+        {"start position", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", chess::GameResult::NONE, true},
+        {"checkmate", "rnb1kbnr/pppp1ppp/8/4p3/6Pq/5P2/PPPPP2P/RNBQKBNR w KQkq - 1 3", chess::GameResult::LOSE, false},
+        {"stalemate", "7k/8/8/8/8/8/5q2/7K w - - 0 1", chess::GameResult::DRAW, false},
+        {"only a pawn move", "7k/8/8/8/8/8/P4q2/7K w - - 0 1", chess::GameResult::NONE, true},
+        {"only knight moves", "7k/8/8/8/8/8/5q2/N6K w - - 0 1", chess::GameResult::NONE, true},
+        {"only bishop moves", "7k/8/8/8/8/8/5q2/B6K w - - 0 1", chess::GameResult::NONE, true},
+        {"insufficient material", "8/8/4k3/8/8/4K3/8/8 w - - 0 1", chess::GameResult::DRAW, true},
+        {"fifty-move rule", "7k/8/8/8/8/8/R7/7K w - - 100 80", chess::GameResult::DRAW, true},
+    };
+    for (const auto& [name, fen, expected, hasMoves] : positions) {
+        std::cout << "Testing game result of " << name << "..." << std::endl;
+        chess::Board board(fen);
+        auto result = GameNode::gameResult(board);
+        if (result == expected && board.isGameOver().second == expected
+            && GameNode::hasLegalMove(board) == hasMoves) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Expected: " << static_cast<int>(expected) << ". Got " << static_cast<int>(result) << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    if (failures) {
+        std::cout << "FAILED: " << failures << "/" << numTests << " TESTS FAILED." << std::endl;
+    } else {
+        std::cout << "SUCCESS: " << numTests << "/" << numTests << " TESTS PASSED." << std::endl;
+    }
+    return failures;
+}
+
+/**
+ * @brief Executes unit tests to validate the NUMA mode: processor lists are parsed as sysfs writes
+ * them, tables are split into one copy per emulated node when replicated and a single copy otherwise,
+ * and the parallel search finds a mate with every placement.
+ *
+ * @return Number of failures.
+ */
+int testNuma()
+{
+    int numTests(0), failures(0);
+    const auto previous = numa::config();
+    std::cout << "Testing processor list parsing..." << std::endl;
+    {
+        auto cpus = numa::parseCpuList("0-3,8,10-11\n");
+        if (cpus == std::vector<int>{0, 1, 2, 3, 8, 10, 11} && numa::parseCpuList("").empty()) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Parsed " << cpus.size() << " processors" << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    const std::vector<std::pair<std::string, TablePlacement>> placements = {
+        {"shared", TablePlacement::SHARED},
+        {"partitioned", TablePlacement::PARTITIONED},
+        {"replicated", TablePlacement::REPLICATED},
+    };
+    for (const auto& [name, placement] : placements) {
+        std::cout << "Testing " << name << " tables on two emulated nodes..." << std::endl;
+        numa::Config config;
+        config.tables = placement;
+        config.emulatedNodes = 2;
+        numa::configure(config);
+
+        TranspositionTable table(1);
+        size_t expectedCopies = placement == TablePlacement::REPLICATED ? 2 : 1;
+        size_t privateCopies = 0;
+        #pragma omp parallel num_threads(2)
+        {
+            TranspositionTable privateTable(1);
+            #pragma omp critical
+            privateCopies = std::max(privateCopies, privateTable.numCopies());
+        } // omp parallel
+
+        // A thread finds its own entries in the copy of its node
+        TableEntry entry;
+        chess::Board board;
+        auto move = chess::Move::make(chess::Square("e2"), chess::Square("e4"));
+        table.store(board.hash(), 3, 17, Bound::EXACT, move);
+        bool found = table.probe(board.hash(), entry);
+
+        constexpr auto startPos = "1k6/6R1/1K6/8/8/8/8/8 w - - 0 1";
+        auto root = std::make_unique<GameNode>(startPos);
+        auto result = alphaBeta(LazySMPTag{}, *root, 3, -score_constants::INFINITE_SCORE, score_constants::INFINITE_SCORE, true, &table);
+        auto bestMove = chess::Move::make(chess::Square("g7"), chess::Square("g8"));
+        if (table.placement() == placement && table.numCopies() == expectedCopies && privateCopies == 1
+            && numa::numNodes() == 2 && numa::currentNode() < 2 && found && entry.move == move && entry.score == 17
+            && result.bestMove == bestMove) {
+            std::cout << "----- PASSED -----" << std::endl;
+        } else {
+            std::cout << "----- FAILED -----" << std::endl;
+            std::cout << "Copies: " << table.numCopies() << "/" << expectedCopies << ", private copies: " << privateCopies
+                      << ", found: " << found << ", best move: " << result.bestMove << std::endl;
+            ++failures;
+        }
+        ++numTests;
+    }
+    numa::configure(previous);
+    if (failures) {
+        std::cout << "FAILED: " << failures << "/" << numTests << " TESTS FAILED." << std::endl;
+    } else {
+        std::cout << "SUCCESS: " << numTests << "/" << numTests << " TESTS PASSED." << std::endl;
+    }
+    return failures;
+}
+
 int main(int argc, char* argv[])
 {
     std::cout << std::endl << "<----- SEQUENTIAL ----->" << std::endl << std::endl;
     auto failures = testCorrectness<SequentialTag>();
+    std::cout << std::endl << "<----- SEQUENTIAL PRINCIPAL VARIATION SEARCH ----->" << std::endl << std::endl;
+    failures += testCorrectness<PVSTag>();
+    std::cout << std::endl << "<----- SEQUENTIAL COMPACT TREE ----->" << std::endl << std::endl;
+    failures += testCorrectness<CompactTreeTag>();
     std::cout << std::endl << "<----- SHARED MEMORY SHARED CUTOFFS ----->" << std::endl << std::endl;
     failures += testCorrectness<SharedCutoffsTag>();
     std::cout << std::endl << "<----- SHARED MEMORY LOCAL CUTOFFS ----->" << std::endl << std::endl;
     failures += testCorrectness<LocalCutoffsTag>();
     std::cout << std::endl << "<----- SHARED MEMORY BLENDED APPROACH ----->" << std::endl << std::endl;
     failures += testCorrectness<BlendedCutoffsTag>();
+    std::cout << std::endl << "<----- SHARED MEMORY YOUNG BROTHERS WAIT ----->" << std::endl << std::endl;
+    failures += testCorrectness<YBWCTag>();
+    std::cout << std::endl << "<----- SHARED MEMORY TASKS ----->" << std::endl << std::endl;
+    failures += testCorrectness<TaskTag>();
+    std::cout << std::endl << "<----- SHARED MEMORY TASKS AT EVERY DEPTH ----->" << std::endl << std::endl;
+    failures += testCorrectness<TaskTag>(TaskTag{0});
+    std::cout << std::endl << "<----- SEQUENTIAL MAKE/UNMAKE ----->" << std::endl << std::endl;
+    failures += testCorrectness<MakeUnmakeTag>();
+    std::cout << std::endl << "<----- SHARED MEMORY LAZY SMP ----->" << std::endl << std::endl;
+    failures += testCorrectness<LazySMPTag>();
+    std::cout << std::endl << "<----- TRANSPOSITION TABLE ----->" << std::endl << std::endl;
+    failures += testTranspositionTable<SequentialTag>(eval_constants::MAX_SCORE);
+    failures += testTranspositionTable<PVSTag>(eval_constants::MAX_SCORE);
+    failures += testTranspositionTable<CompactTreeTag>(eval_constants::MAX_SCORE);
+    failures += testTranspositionTable<SharedCutoffsTag>(eval_constants::MAX_SCORE);
+    failures += testTranspositionTable<YBWCTag>(eval_constants::MAX_SCORE);
+    failures += testTranspositionTable<TaskTag>(eval_constants::MAX_SCORE);
+    failures += testTranspositionTable<MakeUnmakeTag>(score_constants::INFINITE_SCORE);
+    failures += testTranspositionTable<LazySMPTag>(score_constants::INFINITE_SCORE);
+    std::cout << std::endl << "<----- ITERATIVE DEEPENING ----->" << std::endl << std::endl;
+    failures += testIterativeDeepening();
+    std::cout << std::endl << "<----- PRINCIPAL VARIATION ----->" << std::endl << std::endl;
+    failures += testPrincipalVariation();
+    std::cout << std::endl << "<----- QUIESCENCE SEARCH ----->" << std::endl << std::endl;
+    failures += testQuiescence<SequentialTag>();
+    failures += testQuiescence<SharedCutoffsTag>();
+    failures += testQuiescence<YBWCTag>();
+    failures += testQuiescence<TaskTag>();
+    failures += testQuiescence<MakeUnmakeTag>();
+    failures += testQuiescence<LazySMPTag>();
+    std::cout << std::endl << "<----- INCREMENTAL EVALUATION ----->" << std::endl << std::endl;
+    failures += testEvaluation();
+    std::cout << std::endl << "<----- NODE ARENA ----->" << std::endl << std::endl;
+    failures += testNodeArena();
+    std::cout << std::endl << "<----- COMPACT TREE ----->" << std::endl << std::endl;
+    failures += testCompactTree();
+    std::cout << std::endl << "<----- TREE REUSE ----->" << std::endl << std::endl;
+    failures += testTreeReuse();
+    std::cout << std::endl << "<----- PONDERING ----->" << std::endl << std::endl;
+    failures += testPondering();
+    std::cout << std::endl << "<----- SEARCH CONTEXT ----->" << std::endl << std::endl;
+    failures += testSearchContext<SequentialTag>(8);
+    failures += testSearchContext<SharedCutoffsTag>(8);
+    failures += testSearchContext<TaskTag>(8);
+    failures += testSearchContext<MakeUnmakeTag>(search_constants::MAX_DEPTH);
+    failures += testSearchContext<LazySMPTag>(search_constants::MAX_DEPTH);
+    std::cout << std::endl << "<----- UCI ----->" << std::endl << std::endl;
+    failures += testUci();
+    std::cout << std::endl << "<----- BATCH ANALYSIS ----->" << std::endl << std::endl;
+    failures += testBatchAnalysis();
+    std::cout << std::endl << "<----- PERFT ----->" << std::endl << std::endl;
+    failures += testPerft();
+    std::cout << std::endl << "<----- SEARCH STATISTICS ----->" << std::endl << std::endl;
+    failures += testSearchStatistics<SequentialTag>(false);
+    failures += testSearchStatistics<YBWCTag>(true);
+    failures += testSearchStatistics<TaskTag>(true);
+    failures += testSearchStatistics<MakeUnmakeTag>(false);
+    failures += testSearchStatistics<LazySMPTag>(true);
+    std::cout << std::endl << "<----- SELECTIVE SEARCH ----->" << std::endl << std::endl;
+    failures += testSelectiveSearch();
+    std::cout << std::endl << "<----- GAME RESULT ----->" << std::endl << std::endl;
+    failures += testGameResult();
+    std::cout << std::endl << "<----- NUMA ----->" << std::endl << std::endl;
+    failures += testNuma();
     if (failures) {
         std::cout << std::endl << ">>> " << failures << " failures detected." << std::endl;
     }
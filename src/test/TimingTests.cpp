@@ -74,12 +74,23 @@ int main(int argc, char *argv[])
             std::cerr << "std::out_of_range::what() " << e.what() << std::endl;
         }
     }
+    // Parallel searches are correct when they agree with the sequential search on the minimax value
+    auto resultSequential = depthTimingTest<SequentialTag>(depth, startPos[posIdx]);
+    auto correctness = [&](const TimingTestResult& timing) {
+        return timing.result.bestMove.score() == resultSequential.result.bestMove.score() ? "correct" : "incorrect";
+    };
     auto resultShared = depthTimingTest<SharedCutoffsTag>(depth, startPos[posIdx]);
     auto resultLocal = depthTimingTest<LocalCutoffsTag>(depth, startPos[posIdx]);
+    auto resultBlended = depthTimingTestBlended(depth, startPos[posIdx], 1);
     std::cout << resultShared.timeAsDouble()
               << "," << resultShared.nodesExplored()
+              << "," << correctness(resultShared)
               << "," << resultLocal.timeAsDouble()
               << "," << resultLocal.nodesExplored()
+              << "," << correctness(resultLocal)
+              << "," << resultBlended.timeAsDouble()
+              << "," << resultBlended.nodesExplored()
+              << "," << correctness(resultBlended)
               << "," << posIdx
               << std::endl;
 }